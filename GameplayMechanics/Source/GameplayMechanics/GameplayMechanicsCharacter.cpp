@@ -6,7 +6,6 @@
 #include "Components/BoxComponent.h"
 #include "Components/InputComponent.h"
 #include "Interfaces/InteractionInterface.h"
-#include "ActorComponents/DialogComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "GameFramework/Controller.h"
 #include "GameFramework/SpringArmComponent.h"
@@ -15,6 +14,8 @@
 #include "Kismet/GameplayStatics.h"
 #include "Components/WidgetComponent.h"
 #include "Blueprint/UserWidget.h"
+#include "Subsystems/InteractionSubsystem.h"
+#include "Subsystems/WallDetectionSubsystem.h"
 
 //////////////////////////////////////////////////////////////////////////
 // AGameplayMechanicsCharacter
@@ -65,13 +66,19 @@ AGameplayMechanicsCharacter::AGameplayMechanicsCharacter()
 	bBlockInput = false;
 
 	// Interaction
-	bStartTriggerInteractions = false;
-	SelectedInteractableActor = nullptr;
-	NumInteractableObjects = 0;
+	bUseInteractionIndex = false;
+	InteractionDistance = 180.f;
+	InteractionAngle = 60.f;
 
 	//Climbable wall detection
 	MaxDistanceFromWall = 100.f;
 	MaxHeightToJump = 300.f;
+	WallDetectionDistanceThreshold = 2.f;
+	WallDetectionAngleThreshold = 1.f;
+	WallTraceLocation = FVector::ZeroVector;
+	WallTraceDirection = FVector::ZeroVector;
+	bWallTraceValid = false;
+	bWallTracePending = false;
 
 	//Climb controllers
 	bCanJumpToClimb = false;
@@ -89,15 +96,29 @@ void AGameplayMechanicsCharacter::BeginPlay()
 {
 	Super::BeginPlay();
 	ActualPlayerHealth = MaxPlayerHealth;
+
+	UInteractionSubsystem* InteractionSubsystem = GetWorld()->GetSubsystem<UInteractionSubsystem>();
+
+	if (bUseInteractionIndex && InteractionSubsystem != nullptr)
+	{
+		// The grid replaces the trigger, it no longer needs to take part in the overlaps
+		BoxInteractionTrigger->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		InteractionSubsystem->AddIndexedInteractor(GetInteractionOrigin(), InteractionDistance, InteractionAngle);
+	}
 }
 
-void AGameplayMechanicsCharacter::Tick(float DeltaTime)
+void AGameplayMechanicsCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	if (bStartTriggerInteractions && NumInteractableObjects > 1)
+	if (UInteractionSubsystem* InteractionSubsystem = GetWorld()->GetSubsystem<UInteractionSubsystem>())
 	{
-		SelectCloseInteractableActor();
+		InteractionSubsystem->RemoveInteractor(GetInteractionOrigin());
 	}
-	
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AGameplayMechanicsCharacter::Tick(float DeltaTime)
+{
 	if (!bJumpToClimb)
 	{
 		WallDetection();
@@ -107,89 +128,36 @@ void AGameplayMechanicsCharacter::Tick(float DeltaTime)
 //////////////////////////////////////////////////////////////////////////
 // Interaction
 
-void AGameplayMechanicsCharacter::SelectCloseInteractableActor()
+void AGameplayMechanicsCharacter::TriggerInteraction()
 {
-	BoxInteractionTrigger->GetOverlappingActors(OverlappingActors);
+	UInteractionSubsystem* InteractionSubsystem = GetWorld()->GetSubsystem<UInteractionSubsystem>();
+	IInteractionInterface* InteractInterface = InteractionSubsystem != nullptr ? InteractionSubsystem->GetSelectedInteraction(GetInteractionOrigin()) : nullptr;
 
-	AActor* OverlappedActor = nullptr;
-	float NewLength = 0.f;
-	float SelectedActorLength = (SelectedInteractableActor->GetActorLocation() - BoxInteractionTrigger->GetComponentLocation()).Length();
-
-	for (int Index = 0; Index < OverlappingActors.Num(); ++Index)
+	if (InteractInterface != nullptr)
 	{
-		OverlappedActor = OverlappingActors[Index];
-		NewLength = (OverlappedActor->GetActorLocation() - BoxInteractionTrigger->GetComponentLocation()).Length();
-
-		if (NewLength < SelectedActorLength)
-		{
-			SelectedActorLength = NewLength;
-
-			IInteractionInterface* InteractInterface = Cast<IInteractionInterface>(SelectedInteractableActor);
-			InteractInterface->CancelInteraction();
-
-			SelectedInteractableActor = OverlappedActor;
-			InteractInterface = Cast<IInteractionInterface>(SelectedInteractableActor);
-			InteractInterface->PrepareInteraction();
-		}
-
+		InteractInterface->Interaction();
 	}
 }
 
-void AGameplayMechanicsCharacter::TriggerInteraction()
+USceneComponent* AGameplayMechanicsCharacter::GetInteractionOrigin() const
 {
-	if (bStartTriggerInteractions)
-	{
-		IInteractionInterface* InteractInterface = Cast<IInteractionInterface>(SelectedInteractableActor);
-
-		if (InteractInterface == nullptr)
-		{
-			InteractInterface = Cast<IInteractionInterface>(SelectedInteractableActor->GetComponentByClass(UDialogComponent::StaticClass()));
-		}
-
-		InteractInterface->Interaction();
-	}
+	// Measured from the character itself so the interactables beside it are in reach too
+	return bUseInteractionIndex ? static_cast<USceneComponent*>(GetCapsuleComponent()) : BoxInteractionTrigger;
 }
 
 void AGameplayMechanicsCharacter::OnOverlapBegin(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
 {
-	if (NumInteractableObjects == 0)
+	if (UInteractionSubsystem* InteractionSubsystem = GetWorld()->GetSubsystem<UInteractionSubsystem>())
 	{
-		SelectedInteractableActor = OtherActor;
-		bStartTriggerInteractions = true;
-		IInteractionInterface* InteractInterface = Cast<IInteractionInterface>(OtherActor);
-
-		if (InteractInterface == nullptr)
-		{
-			InteractInterface = Cast<IInteractionInterface>(OtherActor->GetComponentByClass(UDialogComponent::StaticClass()));
-		}
-
-		InteractInterface->PrepareInteraction();
+		InteractionSubsystem->AddCandidate(BoxInteractionTrigger, OtherActor);
 	}
-
-	NumInteractableObjects++;
 }
 
 void AGameplayMechanicsCharacter::OnOverlapEnd(class UPrimitiveComponent* OverlappedComp, class AActor* OtherActor, class UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
 {
-	IInteractionInterface* InteractInterface = Cast<IInteractionInterface>(OtherActor);
-
-	if (InteractInterface == nullptr)
-	{
-		InteractInterface = Cast<IInteractionInterface>(OtherActor->GetComponentByClass(UDialogComponent::StaticClass()));
-	}
-
-	InteractInterface->CancelInteraction();
-
-	NumInteractableObjects--;
-
-	if (NumInteractableObjects == 0)
+	if (UInteractionSubsystem* InteractionSubsystem = GetWorld()->GetSubsystem<UInteractionSubsystem>())
 	{
-		SelectedInteractableActor = nullptr;
-		bStartTriggerInteractions = false;
-	}
-	else if (OtherActor == SelectedInteractableActor)
-	{
-		SelectCloseInteractableActor();
+		InteractionSubsystem->RemoveCandidate(BoxInteractionTrigger, OtherActor);
 	}
 }
 
@@ -305,18 +273,57 @@ void AGameplayMechanicsCharacter::MoveRight(float Value)
 
 void AGameplayMechanicsCharacter::WallDetection()
 {
-	UWorld* World = GetWorld();
+	if (bWallTracePending)
+	{
+		return;
+	}
 
-	FVector LineStart = GetActorLocation();
-	FVector LineEnd = GetActorLocation() + GetCapsuleComponent()->GetForwardVector() * MaxDistanceFromWall;
+	// The trace only looks for world static walls, its result holds until the character moves or turns
+	if (bWallTraceValid)
+	{
+		const bool bMoved = FVector::DistSquared(GetActorLocation(), WallTraceLocation) > FMath::Square(WallDetectionDistanceThreshold);
+		const bool bTurned = FVector::DotProduct(GetCapsuleComponent()->GetForwardVector(), WallTraceDirection) < FMath::Cos(FMath::DegreesToRadians(WallDetectionAngleThreshold));
 
-	FCollisionQueryParams CollisionParams;
+		if (!bMoved && !bTurned)
+		{
+			return;
+		}
+	}
+
+	UWallDetectionSubsystem* WallDetectionSubsystem = GetWorld()->GetSubsystem<UWallDetectionSubsystem>();
+
+	if (WallDetectionSubsystem != nullptr)
+	{
+		bWallTracePending = true;
+		WallDetectionSubsystem->RequestWallTrace(this);
+	}
+}
+
+void AGameplayMechanicsCharacter::GetWallTrace(FVector& OutStart, FVector& OutEnd)
+{
+	WallTraceLocation = GetActorLocation();
+	WallTraceDirection = GetCapsuleComponent()->GetForwardVector();
+
+	OutStart = WallTraceLocation;
+	OutEnd = WallTraceLocation + WallTraceDirection * MaxDistanceFromWall;
+}
+
+void AGameplayMechanicsCharacter::OnWallTraceDone(const FHitResult* Hit)
+{
+	bWallTracePending = false;
+
+	// Traced before the jump, ResetClimb asks for a new one
+	if (bJumpToClimb)
+	{
+		return;
+	}
 
-	bCanJumpToClimb = World->LineTraceSingleByObjectType(OutHitForWallJump, LineStart, LineEnd, ECC_WorldStatic, CollisionParams);
+	bWallTraceValid = true;
+	bCanJumpToClimb = Hit != nullptr;
 
-	if (!bCanJumpToClimb)
+	if (bCanJumpToClimb)
 	{
-		bJumpToClimb = false;
+		WallDetectionHit = *Hit;
 	}
 }
 
@@ -327,6 +334,7 @@ void AGameplayMechanicsCharacter::ProcessJump()
 
 	if (bCanJumpToClimb && !bJumpToClimb)
 	{
+		OutHitForWallJump = WallDetectionHit;
 		WallLocation = OutHitForWallJump.Location;
 		WallNormal = OutHitForWallJump.Normal;
 
@@ -443,6 +451,7 @@ void AGameplayMechanicsCharacter::ResetClimb()
 	bJumpToClimb = false;
 	bClimbUp = false;
 	bHangOff = false;
+	bWallTraceValid = false;
 }
 
 //////////////////////////////////////////////////////////////////////////
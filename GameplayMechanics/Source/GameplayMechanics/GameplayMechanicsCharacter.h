@@ -36,10 +36,32 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Jump Detection")
 	float MaxHeightToJump;
 
+	/** Distance the character moves before the wall in front of it is traced again */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Jump Detection")
+	float WallDetectionDistanceThreshold;
+
+	/** Angle in degrees the character turns before the wall in front of it is traced again */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Jump Detection")
+	float WallDetectionAngleThreshold;
+
+	/** Selects interactables from the grid of the interaction subsystem instead of the overlaps of the interaction trigger */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = InteractionTrigger)
+	bool bUseInteractionIndex;
+
+	/** Reach of the interaction when selecting from the interaction subsystem grid */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = InteractionTrigger)
+	float InteractionDistance;
+
+	/** Angle in degrees from the facing of the character within which interactables are selected from the grid */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = InteractionTrigger)
+	float InteractionAngle;
+
 protected:
 
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
 
@@ -92,7 +114,8 @@ private:
 
 	void TriggerInteraction();
 
-	void SelectCloseInteractableActor();
+	// Component the interaction subsystem selects interactables for
+	USceneComponent* GetInteractionOrigin() const;
 
 	void WallDetection();
 
@@ -105,6 +128,12 @@ public:
 	UFUNCTION(BlueprintCallable)
 	void ResetClimb();
 
+	// Segment of the wall trace from the current location and facing, called by UWallDetectionSubsystem when issuing it
+	void GetWallTrace(FVector& OutStart, FVector& OutEnd);
+
+	// Result of the last wall trace, Hit is null when there is no wall in reach
+	void OnWallTraceDone(const FHitResult* Hit);
+
 	UFUNCTION(BlueprintCallable)
 	void ToggleBlockInput();
 
@@ -123,14 +152,16 @@ public:
 
 private:
 
-	bool bStartTriggerInteractions;
-	TArray<AActor*> OverlappingActors;
-
-	AActor* SelectedInteractableActor;
-	int NumInteractableObjects;
 	bool bCanJumpToClimb;
 	FHitResult OutHitForWallJump;
 
+	// Last wall trace, kept while the character stays around where it was traced from
+	FHitResult WallDetectionHit;
+	FVector WallTraceLocation;
+	FVector WallTraceDirection;
+	bool bWallTraceValid;
+	bool bWallTracePending;
+
 	bool bBlockInput;
 
 	FVector WallLocation;
@@ -8,6 +8,7 @@
 #include "Blueprint/UserWidget.h"
 #include "Components/BoxComponent.h"
 #include "Kismet/GameplayStatics.h"
+#include "Subsystems/InteractionSubsystem.h"
 #include "../GameplayMechanicsCharacter.h"
 
 // Sets default values for this component's properties
@@ -35,7 +36,7 @@ UDialogComponent::UDialogComponent()
 	DialogWidget = CreateDefaultSubobject<UUserWidget>(TEXT("Dialog Widget"));
 
 	bDialogTriggered = false;
-	
+	bUseTriggerOverlap = true;
 }
 
 // Called when the game starts
@@ -46,6 +47,16 @@ void UDialogComponent::BeginPlay()
 	FAttachmentTransformRules TransformRules(EAttachmentRule::KeepRelative, false);
 	BoxTrigger->AttachToComponent(GetOwner()->GetRootComponent(), TransformRules);
 
+	if (!bUseTriggerOverlap)
+	{
+		BoxTrigger->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	}
+
+	if (UInteractionSubsystem* InteractionSubsystem = GetWorld()->GetSubsystem<UInteractionSubsystem>())
+	{
+		InteractionSubsystem->RegisterInteractable(GetOwner());
+	}
+
 	if (DialogWidget == nullptr)
 	{
 		UE_LOG(LogTemp, Error, TEXT("NO DIALOG WIDGET CLASS SELECTED!"));
@@ -64,6 +75,16 @@ void UDialogComponent::BeginPlay()
 	// ...
 }
 
+void UDialogComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UInteractionSubsystem* InteractionSubsystem = GetWorld()->GetSubsystem<UInteractionSubsystem>())
+	{
+		InteractionSubsystem->UnregisterInteractable(GetOwner());
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 // Called every frame
 void UDialogComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
@@ -0,0 +1,299 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ActorComponents/MapVisualizerComponent.h"
+#include "SceneActors/MapGenerator.h"
+
+// Sets default values for this component's properties
+UMapVisualizerComponent::UMapVisualizerComponent()
+{
+	// Only ticks to build the dirty layers, once per frame however many times the map changed
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	bTickInEditor = true;
+
+	PointSize = 4.0f;
+	RouteThickness = 2.0f;
+
+	for (int32 Layer = 0; Layer < NumLayers; ++Layer)
+	{
+		bLayerVisible[Layer] = Layer == int32(EMapVisualizerLayer::Grid);
+		bLayerDirty[Layer] = true;
+	}
+}
+
+void UMapVisualizerComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	if (GetOwner() == nullptr || LayerBatches.Num() > 0)
+	{
+		return;
+	}
+
+	for (int32 Layer = 0; Layer < NumLayers; ++Layer)
+	{
+		ULineBatchComponent* Batch = NewObject<ULineBatchComponent>(GetOwner(), NAME_None, RF_Transient);
+
+		// The lines never expire, they are replaced when the layer is built again
+		Batch->PrimaryComponentTick.bCanEverTick = false;
+		Batch->SetupAttachment(this);
+		Batch->SetVisibility(bLayerVisible[Layer]);
+		Batch->RegisterComponent();
+
+		LayerBatches.Add(Batch);
+		bLayerDirty[Layer] = true;
+	}
+
+	SetComponentTickEnabled(true);
+}
+
+void UMapVisualizerComponent::OnUnregister()
+{
+	for (ULineBatchComponent* Batch : LayerBatches)
+	{
+		if (Batch != nullptr)
+		{
+			Batch->DestroyComponent();
+		}
+	}
+
+	LayerBatches.Reset();
+
+	Super::OnUnregister();
+}
+
+void UMapVisualizerComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	for (int32 Layer = 0; Layer < LayerBatches.Num(); ++Layer)
+	{
+		if (!bLayerDirty[Layer] || !bLayerVisible[Layer] || LayerBatches[Layer] == nullptr)
+		{
+			continue;
+		}
+
+		ULineBatchComponent* Batch = LayerBatches[Layer];
+		Batch->BatchedLines.Reset();
+		Batch->BatchedPoints.Reset();
+
+		BuildLayer(EMapVisualizerLayer(Layer), Batch->BatchedLines, Batch->BatchedPoints);
+
+		// One render proxy for the whole layer
+		Batch->MarkRenderStateDirty();
+		bLayerDirty[Layer] = false;
+	}
+
+	SetComponentTickEnabled(false);
+}
+
+void UMapVisualizerComponent::SetLayerVisible(EMapVisualizerLayer Layer, bool bVisible)
+{
+	const int32 LayerIndex = int32(Layer);
+
+	if (LayerIndex >= NumLayers || bLayerVisible[LayerIndex] == bVisible)
+	{
+		return;
+	}
+
+	bLayerVisible[LayerIndex] = bVisible;
+
+	if (LayerBatches.IsValidIndex(LayerIndex) && LayerBatches[LayerIndex] != nullptr)
+	{
+		LayerBatches[LayerIndex]->SetVisibility(bVisible);
+	}
+
+	if (bVisible && bLayerDirty[LayerIndex])
+	{
+		SetComponentTickEnabled(true);
+	}
+}
+
+bool UMapVisualizerComponent::IsLayerVisible(EMapVisualizerLayer Layer) const
+{
+	return int32(Layer) < NumLayers && bLayerVisible[int32(Layer)];
+}
+
+void UMapVisualizerComponent::MarkMapDirty()
+{
+	for (int32 Layer = 0; Layer < NumLayers; ++Layer)
+	{
+		MarkLayerDirty(EMapVisualizerLayer(Layer));
+	}
+}
+
+void UMapVisualizerComponent::MarkLayerDirty(EMapVisualizerLayer Layer)
+{
+	const int32 LayerIndex = int32(Layer);
+
+	if (LayerIndex >= NumLayers)
+	{
+		return;
+	}
+
+	bLayerDirty[LayerIndex] = true;
+
+	if (bLayerVisible[LayerIndex])
+	{
+		SetComponentTickEnabled(true);
+	}
+}
+
+void UMapVisualizerComponent::BuildLayer(EMapVisualizerLayer Layer, TArray<FBatchedLine>& OutLines, TArray<FBatchedPoint>& OutPoints) const
+{
+	const AMapGenerator* MapGenerator = Cast<AMapGenerator>(GetOwner());
+
+	if (MapGenerator == nullptr)
+	{
+		return;
+	}
+
+	auto AddLine = [&OutLines](const FVector2D& Start, const FVector2D& End, float Z, const FLinearColor& Color, float Thickness)
+	{
+		OutLines.Add(FBatchedLine(FVector(Start.X, Start.Y, Z), FVector(End.X, End.Y, Z), Color, 0.0f, Thickness, SDPG_World));
+	};
+
+	auto AddPoint = [this, &OutPoints](const FVector2D& Position, float Z, const FLinearColor& Color)
+	{
+		OutPoints.Add(FBatchedPoint(FVector(Position.X, Position.Y, Z), Color, PointSize, 0.0f, SDPG_World));
+	};
+
+	const FMapGenerationView Map = MapGenerator->GetMapView();
+
+	switch (Layer)
+	{
+	case EMapVisualizerLayer::Grid:
+	{
+		const float GridExtend = MapGenerator->GridExtend;
+		const float CellSize = MapGenerator->SphereRadius / FMath::Sqrt(2.0f);
+		const int32 MaxGridCells = FMath::CeilToInt(GridExtend / CellSize);
+
+		OutLines.Reserve(2 * MaxGridCells + 4);
+
+		const FVector2D Corners[4] = { FVector2D(0.0f, 0.0f), FVector2D(GridExtend, 0.0f), FVector2D(GridExtend, GridExtend), FVector2D(0.0f, GridExtend) };
+
+		for (int32 Corner = 0; Corner < 4; ++Corner)
+		{
+			AddLine(Corners[Corner], Corners[(Corner + 1) % 4], 0.1f, FColor::Green, 0.0f);
+		}
+
+		for (int32 Index = 0; Index < MaxGridCells; ++Index)
+		{
+			AddLine(FVector2D(0.0f, Index * CellSize), FVector2D(GridExtend, Index * CellSize), 0.0f, FColor::Black, 0.0f);
+			AddLine(FVector2D(Index * CellSize, 0.0f), FVector2D(Index * CellSize, GridExtend), 0.0f, FColor::Black, 0.0f);
+		}
+		break;
+	}
+	case EMapVisualizerLayer::Points:
+	{
+		OutPoints.Reserve(Map.GeneratedPoints.Num());
+
+		for (const FVector2D& Point : Map.GeneratedPoints)
+		{
+			AddPoint(Point, 0.0f, FColor::Green);
+		}
+		break;
+	}
+	case EMapVisualizerLayer::Triangulation:
+	{
+		OutLines.Reserve(Map.HalfEdgeTwins.Num() / 2 + Map.GeneratedPoints.Num());
+
+		// Every inner edge is shared by two half-edges, only draw it from the lowest one
+		for (int32 HalfEdge = 0; HalfEdge < Map.HalfEdgeTwins.Num(); ++HalfEdge)
+		{
+			const int32 Twin = Map.HalfEdgeTwins[HalfEdge];
+
+			if (Twin == INDEX_NONE || HalfEdge < Twin)
+			{
+				const FGeneratedTriangle& Triangle = Map.Triangles[HalfEdge / 3];
+				AddLine(Map.GeneratedPoints[Triangle[HalfEdge % 3]], Map.GeneratedPoints[Triangle[FGeneratedTriangle::NextHalfEdge(HalfEdge) % 3]], 0.0f, FColor::Blue, 0.0f);
+			}
+		}
+		break;
+	}
+	case EMapVisualizerLayer::Paths:
+	{
+		// Seeded so a node keeps its colour when the layer is built again
+		FRandomStream ColorRandom(MapGenerator->Seed);
+
+		OutPoints.Reserve(Map.Paths.Num());
+		OutLines.Reserve(Map.PathChildNodes.Num());
+
+		for (int32 Node = 0; Node < Map.Paths.Num(); ++Node)
+		{
+			const FLinearColor NodeColor = FColor(ColorRandom.RandRange(0, 255), ColorRandom.RandRange(0, 255), ColorRandom.RandRange(0, 255));
+			const FVector2D& NodePosition = Map.Paths[Node].NodePosition;
+
+			AddPoint(NodePosition, 0.0f, NodeColor);
+
+			for (const int32 ChildNode : Map.GetChildNodes(Node))
+			{
+				AddLine(NodePosition, Map.Paths[ChildNode].NodePosition, 0.0f, NodeColor, 0.0f);
+			}
+		}
+		break;
+	}
+	case EMapVisualizerLayer::Route:
+	{
+		for (int32 Index = 0; Index < Map.Routes.Num(); ++Index)
+		{
+			const FVector2D& RoutePosition = Map.Paths[Map.Routes[Index]].NodePosition;
+			AddPoint(RoutePosition, 1.0f, FColor::Black);
+
+			if (Index > 0)
+			{
+				AddLine(Map.Paths[Map.Routes[Index - 1]].NodePosition, RoutePosition, 1.0f, FColor::Black, RouteThickness);
+			}
+		}
+		break;
+	}
+	case EMapVisualizerLayer::Chunks:
+	{
+		const FMapChunkStreamer* MapChunks = MapGenerator->GetMapChunks();
+
+		if (MapChunks == nullptr)
+		{
+			break;
+		}
+
+		int32 NumTriangles = 0;
+
+		for (const FIntPoint& Coord : MapChunks->GetLoadedChunks())
+		{
+			NumTriangles += MapChunks->FindChunk(Coord)->Triangles.Num();
+		}
+
+		// Chunks have no half-edge twins and an edge on the border of a chunk is also in the triangles of its neighbour,
+		// so edges are drawn once by their end positions
+		TSet<TPair<FVector2D, FVector2D>> DrawnEdges;
+		DrawnEdges.Reserve(NumTriangles * 3 / 2);
+		OutLines.Reserve(NumTriangles * 3 / 2);
+
+		for (const FIntPoint& Coord : MapChunks->GetLoadedChunks())
+		{
+			const FMapChunk* Chunk = MapChunks->FindChunk(Coord);
+
+			for (const FGeneratedTriangle& Triangle : Chunk->Triangles)
+			{
+				for (int32 Corner = 0; Corner < 3; ++Corner)
+				{
+					const FVector2D& Start = Chunk->Points[Triangle[Corner]];
+					const FVector2D& End = Chunk->Points[Triangle[(Corner + 1) % 3]];
+					const bool bStartFirst = Start.X < End.X || (Start.X == End.X && Start.Y < End.Y);
+
+					bool bAlreadyDrawn = false;
+					DrawnEdges.Add(bStartFirst ? MakeTuple(Start, End) : MakeTuple(End, Start), &bAlreadyDrawn);
+
+					if (!bAlreadyDrawn)
+					{
+						AddLine(Start, End, 0.0f, FColor::Blue, 0.0f);
+					}
+				}
+			}
+		}
+		break;
+	}
+	default:
+		break;
+	}
+}
@@ -0,0 +1,43 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AsyncActions/GenerateMapAsyncAction.h"
+#include "SceneActors/MapGenerator.h"
+
+UGenerateMapAsyncAction* UGenerateMapAsyncAction::GenerateMap(AMapGenerator* MapGenerator)
+{
+	UGenerateMapAsyncAction* Action = NewObject<UGenerateMapAsyncAction>();
+	Action->MapGenerator = MapGenerator;
+	Action->RegisterWithGameInstance(MapGenerator);
+
+	return Action;
+}
+
+void UGenerateMapAsyncAction::Activate()
+{
+	if (!IsValid(MapGenerator))
+	{
+		Cancelled.Broadcast(MapGenerator);
+		SetReadyToDestroy();
+		return;
+	}
+
+	// Bound after starting, so cancelling a generation already in flight does not end this one
+	MapGenerator->GenerateMapAsync();
+	MapGenerator->OnMapGenerated.AddDynamic(this, &UGenerateMapAsyncAction::HandleMapGenerated);
+}
+
+void UGenerateMapAsyncAction::HandleMapGenerated(AMapGenerator* InMapGenerator, bool bCompleted)
+{
+	InMapGenerator->OnMapGenerated.RemoveDynamic(this, &UGenerateMapAsyncAction::HandleMapGenerated);
+
+	if (bCompleted)
+	{
+		Completed.Broadcast(InMapGenerator);
+	}
+	else
+	{
+		Cancelled.Broadcast(InMapGenerator);
+	}
+
+	SetReadyToDestroy();
+}
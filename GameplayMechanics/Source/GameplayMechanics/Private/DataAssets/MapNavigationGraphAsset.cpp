@@ -0,0 +1,37 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "DataAssets/MapNavigationGraphAsset.h"
+#include "Routing/RouteSearch.h"
+
+void UMapNavigationGraphAsset::Serialize(FArchive& Ar)
+{
+	Super::Serialize(Ar);
+
+	Ar << Graph;
+}
+
+void UMapNavigationGraphAsset::Build(const FMapGenerationView& Map)
+{
+	Graph.Build(Map);
+}
+
+int32 UMapNavigationGraphAsset::GetNumNodes() const
+{
+	return Graph.GetNumNodes();
+}
+
+FVector2D UMapNavigationGraphAsset::GetNodePosition(int32 Node) const
+{
+	return Node >= 0 && Node < Graph.GetNumNodes() ? Graph.GetNodePosition(Node) : FVector2D::ZeroVector;
+}
+
+int32 UMapNavigationGraphAsset::FindNearestNode(FVector2D Position) const
+{
+	return Graph.FindNearestNode(Position);
+}
+
+bool UMapNavigationGraphAsset::FindRoute(int32 Start, int32 Goal, TArray<int32>& OutRoute) const
+{
+	FRouteSearch Search;
+	return Search.FindRoute(Graph, Start, Goal, OutRoute);
+}
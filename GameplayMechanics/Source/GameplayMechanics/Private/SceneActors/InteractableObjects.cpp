@@ -3,6 +3,7 @@
 #include "SceneActors/InteractableObjects.h"
 #include "Components/BoxComponent.h"
 #include "Components/WidgetComponent.h"
+#include "Subsystems/InteractionSubsystem.h"
 
 // Sets default values
 AInteractableObjects::AInteractableObjects()
@@ -19,7 +20,8 @@ AInteractableObjects::AInteractableObjects()
 	InteractButtonWidget->SetupAttachment(BoxTrigger);
 	InteractButtonWidget->SetWidgetSpace(EWidgetSpace::Screen);
 	InteractButtonWidget->SetDrawSize(FVector2D(50.f, 50.f));
-	
+
+	bUseTriggerOverlap = true;
 }
 
 // Called when the game starts or when spawned
@@ -27,6 +29,26 @@ void AInteractableObjects::BeginPlay()
 {
 	Super::BeginPlay();
 	InteractButtonWidget->SetVisibility(false);
+
+	if (!bUseTriggerOverlap)
+	{
+		BoxTrigger->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	}
+
+	if (UInteractionSubsystem* InteractionSubsystem = GetWorld()->GetSubsystem<UInteractionSubsystem>())
+	{
+		InteractionSubsystem->RegisterInteractable(this);
+	}
+}
+
+void AInteractableObjects::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UInteractionSubsystem* InteractionSubsystem = GetWorld()->GetSubsystem<UInteractionSubsystem>())
+	{
+		InteractionSubsystem->UnregisterInteractable(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 // Called every frame
@@ -1,9 +1,31 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "SceneActors/MapGenerator.h"
-#include "DrawDebugHelpers.h"
-#include "GenericPlatform/GenericPlatformMath.h"
-#include "Kismet/KismetSystemLibrary.h"
+#include "ActorComponents/MapVisualizerComponent.h"
+#include "DataAssets/MapNavigationGraphAsset.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/Paths.h"
+#include <atomic>
+
+// Pipeline of an asynchronous generation, shared with its tasks so it outlives the actor
+struct FMapGenerationAsyncState
+{
+	FMapGenerationPipeline Pipeline;
+
+	std::atomic<int32> NumCompletedStages { 0 };
+	std::atomic<bool> bCancelled { false };
+};
+
+using FMapGenerationStage = void (FMapGenerationPipeline::*)();
+
+static const FMapGenerationStage MapGenerationStages[] =
+{
+	&FMapGenerationPipeline::PoisonDiskSampling,
+	&FMapGenerationPipeline::DelaunaryTriangulation,
+	&FMapGenerationPipeline::GeneratePaths,
+	&FMapGenerationPipeline::FindRoutes,
+};
 
 // Sets default values
 AMapGenerator::AMapGenerator()
@@ -11,6 +33,10 @@ AMapGenerator::AMapGenerator()
  	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = true;
 
+	// Its line batches draw in world space, the map stays at the world origin wherever the actor is
+	MapVisualizer = CreateDefaultSubobject<UMapVisualizerComponent>(TEXT("MapVisualizer"));
+	RootComponent = MapVisualizer;
+
 	Seed = 123456789;
 	GridExtend = 50.0f;
 	SphereRadius = 5.0f;
@@ -18,9 +44,21 @@ AMapGenerator::AMapGenerator()
 	NumSampleBeforeRejection = 1;
 	bCheckWellGenerated = false;
 
+	bUseMapCache = true;
+	MapCacheDirectory = TEXT("MapCache");
+
+	bStreamMapChunks = false;
+	ChunkLoadRadius = 2;
+	ChunkMemoryBudgetMiB = 64.0f;
+
 	bDebugGrid = true;
 	bDebugPoisonDisk = false;
 	bDebugDelaunary = false;
+	bDebugGeneratedPath = false;
+	bDebugMapChunks = false;
+
+	NavigationGraph = nullptr;
+	NumRouteThreads = 0;
 	
 	PathfindingIterations = 1;
 }
@@ -31,571 +69,417 @@ void AMapGenerator::BeginPlay()
 	Super::BeginPlay();
 }
 
-void AMapGenerator::MyPoisonDiskSamplingAlgorithm()
+void AMapGenerator::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Random = FRandomStream(Seed);
+	CancelMapGeneration();
 
-	const float PISimplified = 3.141592654f;
+	Super::EndPlay(EndPlayReason);
+}
 
-	const FVector2D RegionSize = FVector2D(GridExtend, GridExtend);
-	const float CellSize = SphereRadius / FMath::Sqrt(2.0f);
-	const int MaxGridCellsX = ceil(GridExtend / CellSize);
-	const int MaxGridCellsY = MaxGridCellsX;
-	const int GridSize = MaxGridCellsX * MaxGridCellsY;
+void AMapGenerator::UpdateGeneratorSettings()
+{
+	Generator.Settings.Seed = Seed;
+	Generator.Settings.GridExtend = GridExtend;
+	Generator.Settings.SphereRadius = SphereRadius;
+	Generator.Settings.Iterations = Iterations;
+	Generator.Settings.NumSampleBeforeRejection = NumSampleBeforeRejection;
+	Generator.Settings.bCheckWellGenerated = bCheckWellGenerated;
+}
 
-	GeneratedPoints.Reset(0);
-	Grid.Reset(0);
-	Grid.SetNumZeroed(GridSize);
+FMapGenerationView AMapGenerator::GetMapView() const
+{
+	return CachedMap.IsValid() ? CachedMap->GetView() : Generator.GetView();
+}
 
-	TArray<FVector2D> SpawnPoints;
+void AMapGenerator::MaterializeCachedMap()
+{
+	if (CachedMap.IsValid())
+	{
+		Generator.LoadView(CachedMap->GetView());
+		CachedMap.Reset();
+	}
+}
 
-	//StartedPoint, we try with the middle point
-	FVector2D StartedPoint = FVector2D(GridExtend / 2.0f, GridExtend / 2.0f);
-	SpawnPoints.Add(StartedPoint);
+FString AMapGenerator::GetMapCacheDirectory() const
+{
+	return FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir(), MapCacheDirectory);
+}
 
-	if (Iterations < 0 || Iterations >= MAX_int32)
+bool AMapGenerator::LoadCachedMap()
+{
+	if (!bUseMapCache)
 	{
-		Iterations = MAX_int32;
+		return false;
 	}
 
-	while (SpawnPoints.Num() > 0 && Iterations > 0)
+	TUniquePtr<FMapGenerationCacheFile> File = FMapGenerationCache(GetMapCacheDirectory()).Load(Generator.Settings);
+
+	if (!File.IsValid())
 	{
-		const int RandomSpawnIndex = Random.RandRange(0, SpawnPoints.Num() - 1);
-		const FVector2D SpawnRandomPoint = SpawnPoints[RandomSpawnIndex];
+		return false;
+	}
 
-		if (Iterations == 1)
-		{
-			int x = 1;
-		}
+	CachedMap = MoveTemp(File);
 
-		bool bCandidateAccepted = false;
+	StartPoint = CachedMap->GetView().StartPoint;
+	EndPoint = CachedMap->GetView().EndPoint;
+	MapVisualizer->MarkMapDirty();
+	return true;
+}
 
-		for (int Index = 0; Index < NumSampleBeforeRejection; ++Index)
-		{
-			const float Angle = Random.FRand() * PISimplified * 2;
-			const FVector2D Direction = FVector2D(FMath::Sin(Angle), FMath::Cos(Angle));
-			const FVector2D CandidatePoint = SpawnRandomPoint + Direction * Random.RandRange(SphereRadius, SphereRadius * 2.0f);
+void AMapGenerator::GenerateMap()
+{
+	CancelMapGeneration();
+	UpdateGeneratorSettings();
+	Random = FRandomStream(Seed);
 
-			if (IsMyCandidateValid(CandidatePoint, RegionSize, CellSize, Grid))
-			{
-				GeneratedPoints.Add(CandidatePoint);
-				SpawnPoints.Add(CandidatePoint);
+	if (LoadCachedMap())
+	{
+		return;
+	}
 
-				const int LocationX = (int)(CandidatePoint.X / CellSize);
-				const int LocationY = (int)(CandidatePoint.Y / CellSize);
+	CachedMap.Reset();
 
-				const int GridIndex = MaxGridCellsX * LocationX + LocationY;
-				Grid[GridIndex] = GeneratedPoints.Num();
-				bCandidateAccepted = true;
-				break;
-			}
+	Generator.Generate();
 
-		}
+	StartPoint = Generator.StartPoint;
+	EndPoint = Generator.EndPoint;
+	MapVisualizer->MarkMapDirty();
 
-		if (!bCandidateAccepted)
-		{
-			SpawnPoints.RemoveAt(RandomSpawnIndex);
-		}
-		Iterations -= 1;
+	if (bUseMapCache)
+	{
+		FMapGenerationCache(GetMapCacheDirectory()).Save(Generator.Settings, Generator.GetView());
 	}
+}
 
-	StartPoint = FVector2D(-10.0f, GridExtend/2.0f);
-	EndPoint = FVector2D(GridExtend + 10.0f, GridExtend / 2.0f);
-
-	GeneratedPoints.Add(StartPoint);
-	GeneratedPoints.Add(EndPoint);
-
-	for (int Index = 0; Index < SpawnPoints.Num() - 2; ++Index)
-	{
-		FVector2D Pos = SpawnPoints[Index];
+void AMapGenerator::MyPoisonDiskSamplingAlgorithm()
+{
+	CancelMapGeneration();
+	UpdateGeneratorSettings();
+	Random = FRandomStream(Seed);
 
-		for (int NextIndex = Index + 1; NextIndex < SpawnPoints.Num(); ++NextIndex)
-		{
-			FVector2D NextPos = SpawnPoints[NextIndex];
+	CachedMap.Reset();
 
-			FVector2D Dist = NextPos - Pos;
-			float SqrtDistance = Dist.SizeSquared();
+	Generator.PoisonDiskSampling();
 
-			if (SqrtDistance < SphereRadius * SphereRadius)
-			{
-				UE_LOG(LogTemp, Warning, TEXT("Bad Disck Noise Sample"));
-			}
-		}
-	}
+	StartPoint = Generator.StartPoint;
+	EndPoint = Generator.EndPoint;
+	MapVisualizer->MarkMapDirty();
 }
 
-bool AMapGenerator::IsMyCandidateValid(FVector2D Candidate, FVector2D RegionSize, float CellSize, TArray<int> GridCells)
+void AMapGenerator::DelaunaryTriangulation()
 {
-	if (Candidate.X >= 0 && Candidate.X < RegionSize.X && Candidate.Y >= 0 && Candidate.Y < RegionSize.Y)
-	{
-		int LocationX = (int)(Candidate.X / CellSize);
-		int LocationY = (int)(Candidate.Y / CellSize);
-
-		//To search 5 by 5 around the cell
-		int SearchStartX = FMath::Max(0, LocationX - 2);
-		int SearchEndX = FMath::Min(LocationX + 2, RegionSize.X / CellSize);
+	CancelMapGeneration();
+	MaterializeCachedMap();
+	UpdateGeneratorSettings();
+	Generator.DelaunaryTriangulation();
+	MapVisualizer->MarkMapDirty();
+}
 
-		int SearchStartY = FMath::Max(0, LocationY - 2);
-		int SearchEndY = FMath::Min(LocationY + 2, RegionSize.Y/ CellSize);
+void AMapGenerator::GeneratePaths()
+{
+	CancelMapGeneration();
+	MaterializeCachedMap();
+	UpdateGeneratorSettings();
+	Generator.GeneratePaths();
 
-		for (int X = SearchStartX; X <= SearchEndX; ++X)
-		{
-			for (int Y = SearchStartY; Y <= SearchEndY; ++Y)
-			{
-				int Index = ceil(RegionSize.X/CellSize) * X + Y;
+	FindRoutes();
+}
 
-				if (Index >= GridCells.Num())
-				{
-					return false;
-				}
+void AMapGenerator::FindRoutes()
+{
+	CancelMapGeneration();
+	MaterializeCachedMap();
+	Generator.FindRoutes();
+	MapVisualizer->MarkMapDirty();
+}
 
-				int PointIndex = GridCells[Index] - 1;
+void AMapGenerator::FindMapRoutes(const TArray<FIntPoint>& Queries, TArray<int32>& OutRouteOffsets, TArray<int32>& OutRouteNodes)
+{
+	RouteQueries.Reset(Queries.Num());
 
-				if (PointIndex != -1)
-				{
-					FVector2D Point = GeneratedPoints[PointIndex];
-					FVector2D Dist = Candidate - Point;
-					float SqrtDistance = Dist.SizeSquared();
+	for (const FIntPoint& Query : Queries)
+	{
+		RouteQueries.Add(FRouteQuery(Query.X, Query.Y));
+	}
 
-					if (SqrtDistance < SphereRadius * SphereRadius)
-					{
-						return false;
-					}
+	FindMapRouteBatch(RouteQueries, RouteResults);
 
-				}
+	OutRouteOffsets = RouteResults.RouteOffsets;
+	OutRouteNodes = RouteResults.RouteNodes;
+}
 
-			}
-		}
+void AMapGenerator::FindMapRouteBatch(TConstArrayView<FRouteQuery> Queries, FRouteBatchResult& OutRoutes)
+{
+	// Read in place, a map loaded from the cache does not have to be copied into Generator
+	const FMapGenerationView Map = GetMapView();
+	RouteBatch.FindRoutes(Map.Paths, Map.PathChildNodes, Queries, NumRouteThreads, OutRoutes);
+}
 
-		return true;
+void AMapGenerator::ExportNavigationGraph()
+{
+	if (NavigationGraph == nullptr)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s has no navigation graph asset to export to"), *GetName());
+		return;
 	}
 
-	return false;
+	NavigationGraph->Build(GetMapView());
+	NavigationGraph->MarkPackageDirty();
 }
 
-void AMapGenerator::DelaunaryTriangulation()
+int32 AMapGenerator::AddMapPoint(FVector2D Position)
 {
-	if (GeneratedPoints.Num() > 0)
-	{
-		Triangles.Reset(0);
-		Edges.Reset(0);
+	CancelMapGeneration();
+	MaterializeCachedMap();
+	MapVisualizer->MarkMapDirty();
+	return Generator.AddPoint(Position);
+}
 
-		FVector2D MinVertices = GeneratedPoints[0];
-		FVector2D MaxVertices = MinVertices;
+bool AMapGenerator::RemoveMapPoint(int32 PointIndex)
+{
+	CancelMapGeneration();
+	MaterializeCachedMap();
+	MapVisualizer->MarkMapDirty();
+	return Generator.RemovePoint(PointIndex);
+}
 
-		//Generating the Super Triangle
-		FVector2D Vertice;
-		for (int Index = 1; Index < GeneratedPoints.Num(); ++Index)
-		{
-			Vertice = GeneratedPoints[Index];
+bool AMapGenerator::MoveMapPoint(int32 PointIndex, FVector2D NewPosition)
+{
+	CancelMapGeneration();
+	MaterializeCachedMap();
+	MapVisualizer->MarkMapDirty();
+	return Generator.MovePoint(PointIndex, NewPosition);
+}
 
-			if (Vertice.X > MaxVertices.X) MaxVertices.X = Vertice.X;
-			if (Vertice.Y > MaxVertices.Y) MaxVertices.Y = Vertice.Y;
-			if (Vertice.X < MinVertices.X) MinVertices.X = Vertice.X;
-			if (Vertice.X < MinVertices.Y) MinVertices.Y = Vertice.X;
-		}
+void AMapGenerator::UpdateStartEndPoints()
+{
+	CancelMapGeneration();
+	MaterializeCachedMap();
 
-		const float Dx = MaxVertices.X - MinVertices.X;
-		const float Dy = MaxVertices.Y - MinVertices.Y;
+	// Nothing generated yet, the points are placed by the sampling
+	if (Generator.StartPointIndex == INDEX_NONE)
+	{
+		return;
+	}
 
-		const float DeltaMax = FMath::Max(Dx, Dy);
+	// A refused position snaps back to the generated one
+	if (!Generator.SetStartPoint(StartPoint))
+	{
+		StartPoint = Generator.StartPoint;
+	}
 
-		const float MidX = (MaxVertices.X + MinVertices.X) / 2.0f;
-		const float MidY = (MaxVertices.Y + MinVertices.Y) / 2.0f;
+	if (!Generator.SetEndPoint(EndPoint))
+	{
+		EndPoint = Generator.EndPoint;
+	}
 
-		FVector2D LeftVertex = FVector2D(MidX - 50.0f * DeltaMax, MidY - DeltaMax);
-		FVector2D RightVertex = FVector2D(MidX + 50.0f * DeltaMax, MidY - DeltaMax);
-		FVector2D UpVertex = FVector2D(MidX, MidY + 50.0f * DeltaMax);
+	MapVisualizer->MarkMapDirty();
+}
 
-		FGeneratedTriangle SuperTriangle = FGeneratedTriangle(LeftVertex, RightVertex, UpVertex);
-		
-		Triangles.Add(SuperTriangle);
+void AMapGenerator::GenerateMapAsync()
+{
+	CancelMapGeneration();
+	UpdateGeneratorSettings();
 
-		for (int Index = 0; Index < GeneratedPoints.Num(); ++Index)
-		{
-			TArray<FGeneratedEdge> Polygons;
-			
-			for (int TriangleIndex = 0; TriangleIndex < Triangles.Num(); ++TriangleIndex)
-			{
-				if (Triangles[TriangleIndex].CircumCircleContains(GeneratedPoints[Index]))
-				{
-					Triangles[TriangleIndex].bIsBad = true;
-
-					Polygons.Add(FGeneratedEdge(Triangles[TriangleIndex].Vertex1, Triangles[TriangleIndex].Vertex2));
-					Polygons.Add(FGeneratedEdge(Triangles[TriangleIndex].Vertex2, Triangles[TriangleIndex].Vertex3));
-					Polygons.Add(FGeneratedEdge(Triangles[TriangleIndex].Vertex3, Triangles[TriangleIndex].Vertex1));
-				}
-			}
+	// Read in place like GenerateMap does, there is nothing left to generate
+	if (LoadCachedMap())
+	{
+		OnMapGenerated.Broadcast(this, true);
+		return;
+	}
 
-			for (int TriangleIndex = 0; TriangleIndex < Triangles.Num(); ++TriangleIndex) //Can change to lamda function
-			{
-				if (Triangles[TriangleIndex].bIsBad)
-				{
-					Triangles.RemoveAt(TriangleIndex);
-					TriangleIndex -= 1;
-				}
-			}
+	TSharedRef<FMapGenerationAsyncState, ESPMode::ThreadSafe> State = SpareGeneration.IsValid() ? SpareGeneration.ToSharedRef() : MakeShared<FMapGenerationAsyncState, ESPMode::ThreadSafe>();
+	SpareGeneration.Reset();
 
-			for (int PolygonIndex = 0; PolygonIndex < Polygons.Num(); ++PolygonIndex)
-			{
-				for (int NextPolygonIndex = PolygonIndex + 1; NextPolygonIndex < Polygons.Num(); ++NextPolygonIndex)
-				{
-					FGeneratedEdge A = Polygons[PolygonIndex];
-					FGeneratedEdge B = Polygons[NextPolygonIndex];
-
-					if ((FMath::IsNearlyEqual(A.StartPoint.X,B.StartPoint.X) && FMath::IsNearlyEqual(A.StartPoint.Y, B.StartPoint.Y) &&
-						FMath::IsNearlyEqual(A.EndPoint.X, B.EndPoint.X) && FMath::IsNearlyEqual(A.EndPoint.Y, B.EndPoint.Y) )|| 
-						(FMath::IsNearlyEqual(A.StartPoint.X, B.EndPoint.X) && FMath::IsNearlyEqual(A.StartPoint.Y, B.EndPoint.Y) &&
-						FMath::IsNearlyEqual(A.EndPoint.X, B.StartPoint.X) && FMath::IsNearlyEqual(A.EndPoint.Y, B.StartPoint.Y))) 
-					{
-						Polygons[PolygonIndex].bIsBad = true;
-						Polygons[NextPolygonIndex].bIsBad = true;
-					}
-				}
-			}
+	State->Pipeline.Settings = Generator.Settings;
+	State->NumCompletedStages = 0;
+	State->bCancelled = false;
+	AsyncGeneration = State;
 
-			for (int PolygonIndex = 0; PolygonIndex < Polygons.Num(); ++PolygonIndex)
-			{
-				if (Polygons[PolygonIndex].bIsBad)
-				{
-					Polygons.RemoveAt(PolygonIndex);
-					PolygonIndex -= 1;
-				}
-			}
+	// One background task per stage, each waiting for the previous one, then the swap on the game thread
+	FGraphEventArray PreviousStage;
 
-			for (int PolygonIndex = 0; PolygonIndex < Polygons.Num(); ++PolygonIndex)
+	for (const FMapGenerationStage Stage : MapGenerationStages)
+	{
+		FGraphEventRef StageEvent = FFunctionGraphTask::CreateAndDispatchWhenReady([State, Stage]()
+		{
+			if (!State->bCancelled)
 			{
-				Triangles.Add(FGeneratedTriangle(Polygons[PolygonIndex].StartPoint, Polygons[PolygonIndex].EndPoint, GeneratedPoints[Index]));
+				(State->Pipeline.*Stage)();
+				++State->NumCompletedStages;
 			}
-		}
-
-		//Remove Triangles that have conections with the super triangle
-		for (int TriangleIndex = 0; TriangleIndex < Triangles.Num(); ++TriangleIndex)
-		{
-			FGeneratedTriangle Triangle = Triangles[TriangleIndex];
+		}, TStatId(), &PreviousStage, ENamedThreads::AnyBackgroundThreadNormalTask);
 
-			bool bContainSuperTriangle = false;
+		PreviousStage.Reset();
+		PreviousStage.Add(StageEvent);
+	}
 
-			if (Triangle.Vertex1 == LeftVertex || Triangle.Vertex2 == LeftVertex || Triangle.Vertex3 == LeftVertex)
-			{
-				bContainSuperTriangle = true;
-			}
-			else if (Triangle.Vertex1 == RightVertex || Triangle.Vertex2 == RightVertex || Triangle.Vertex3 == RightVertex)
-			{
-				bContainSuperTriangle = true;
-			}
-			else if (Triangle.Vertex1 == UpVertex || Triangle.Vertex2 == UpVertex || Triangle.Vertex3 == UpVertex)
+	// Saved before the swap, which hands the pipeline over to the game thread
+	if (bUseMapCache)
+	{
+		FGraphEventRef SaveEvent = FFunctionGraphTask::CreateAndDispatchWhenReady([State, CacheDirectory = GetMapCacheDirectory()]()
+		{
+			if (!State->bCancelled)
 			{
-				bContainSuperTriangle = true;
+				FMapGenerationCache(CacheDirectory).Save(State->Pipeline.Settings, State->Pipeline.GetView());
 			}
+		}, TStatId(), &PreviousStage, ENamedThreads::AnyBackgroundThreadNormalTask);
 
-			if (bContainSuperTriangle)
-			{
-				Triangles.RemoveAt(TriangleIndex);
-				TriangleIndex -= 1;
-			}
-		}
+		PreviousStage.Reset();
+		PreviousStage.Add(SaveEvent);
+	}
 
-		for (int TriangleIndex = 0; TriangleIndex < Triangles.Num(); ++TriangleIndex)
+	TWeakObjectPtr<AMapGenerator> WeakThis(this);
+
+	FFunctionGraphTask::CreateAndDispatchWhenReady([WeakThis, State]()
+	{
+		if (AMapGenerator* MapGenerator = WeakThis.Get())
 		{
-			Edges.Add(FGeneratedEdge(Triangles[TriangleIndex].Vertex1, Triangles[TriangleIndex].Vertex2));
-			Edges.Add(FGeneratedEdge(Triangles[TriangleIndex].Vertex2, Triangles[TriangleIndex].Vertex3));
-			Edges.Add(FGeneratedEdge(Triangles[TriangleIndex].Vertex3, Triangles[TriangleIndex].Vertex1));
+			MapGenerator->FinishMapGeneration(State);
 		}
-	}
+	}, TStatId(), &PreviousStage, ENamedThreads::GameThread);
 }
 
-void AMapGenerator::GeneratePaths()
+void AMapGenerator::CancelMapGeneration()
 {
-	Paths.Reset(0);
-
-	//Pre generate the points on Path
-	FGeneratedNode StartingPointPath;
-	StartingPointPath.NodePosition = StartPoint;
-	Paths.Add(StartingPointPath);
-
-	for (int Index = 0; Index < GeneratedPoints.Num()-2; ++Index)
+	if (!AsyncGeneration.IsValid())
 	{
-		FGeneratedNode PathNode;
-		PathNode.NodePosition = GeneratedPoints[Index];
-		Paths.Add(PathNode);
+		return;
 	}
 
-	FGeneratedNode EndPointPath;
-	EndPointPath.NodePosition = EndPoint;
-	Paths.Add(EndPointPath);
+	// The tasks skip their stage and the swap ignores the state, it is dropped with the last task
+	AsyncGeneration->bCancelled = true;
+	AsyncGeneration.Reset();
 
-	for (int Index = 0; Index < Paths.Num(); ++Index)
-	{
-		FVector2D* NodePosition = &Paths[Index].NodePosition;
-
-		for (auto EdgeIt = Edges.CreateConstIterator(); EdgeIt; ++EdgeIt)
-		{
-			FVector2D EdgePosition = FVector2D(-1.0f);
+	OnMapGenerated.Broadcast(this, false);
+}
 
-			if (EdgeIt->StartPoint.Equals(*NodePosition))
-			{
-				EdgePosition = EdgeIt->EndPoint;
-			}
-			else if (EdgeIt->EndPoint.Equals(*NodePosition))
-			{
-				EdgePosition = EdgeIt->StartPoint;
-			}
+bool AMapGenerator::IsGeneratingMap() const
+{
+	return AsyncGeneration.IsValid();
+}
 
-			if (EdgePosition.X != -1)
-			{
-				if ((EdgePosition.X - NodePosition->X) > SphereRadius / 3.0f)
-				{
-					FGeneratedNode* TrackedNode = nullptr;
-					for (auto It = Paths.CreateConstIterator(); It; ++It)
-					{
-						if (It->NodePosition.Equals(EdgePosition))
-						{
-							TrackedNode = &Paths[It.GetIndex()];
-							break;
-						}
-					}
-
-					if (TrackedNode != nullptr)
-					{
-						bool bIsAlreadyAChild = false;
-
-						for (int IndexChild = 0; IndexChild < Paths[Index].ChildNodes.Num(); ++IndexChild)
-						{
-							if (TrackedNode->NodePosition.Equals(Paths[Index].ChildNodes[IndexChild]->NodePosition))
-							{
-								bIsAlreadyAChild = true;
-								break;
-							}
-						}
-
-						if (!bIsAlreadyAChild)
-						{
-							Paths[Index].ChildNodes.Add(TrackedNode);	
-							TrackedNode->ParentNode = &Paths[Index];
-						}
-						
-					}
-				}
-			}
-		}
+float AMapGenerator::GetMapGenerationProgress() const
+{
+	if (!AsyncGeneration.IsValid())
+	{
+		return 1.0f;
 	}
 
-	FindRoutes();
+	return float(AsyncGeneration->NumCompletedStages) / float(UE_ARRAY_COUNT(MapGenerationStages));
 }
 
-void AMapGenerator::FindRoutes()
+void AMapGenerator::FinishMapGeneration(const TSharedRef<FMapGenerationAsyncState, ESPMode::ThreadSafe>& State)
 {
-	Routes.Reset(0);
-	TArray<FGeneratedNode> Open;
-	TArray<FGeneratedNode> Close;
-
-	FGeneratedNode* CurrentOpen = nullptr;
-	FGeneratedNode* CurrentClose = nullptr;
-
-	const FGeneratedNode* Goal = &Paths[Paths.Num() - 1];
-
-	Open.Add(Paths[0]);
-
-	while (Open.Num() > 0)
+	if (AsyncGeneration != State)
 	{
-		int MinValue = INT_MAX;
-		int OpenIndex = -1;
-		for (auto It = Open.CreateConstIterator(); It; ++It)
-		{
-			FVector2D DistanceVector = Goal->NodePosition - It->NodePosition;
-			float Distance = DistanceVector.Size() + It->Score;
+		return;
+	}
 
-			if (Distance < MinValue)
-			{
-				MinValue = Distance;
-				OpenIndex = It.GetIndex();
-				CurrentOpen = &Open[OpenIndex];
-			}	
-		}
+	AsyncGeneration.Reset();
 
-		if (CurrentOpen != nullptr)
-		{
-			Close.Add(*CurrentOpen);
-			CurrentClose = &Close[Close.Num() - 1];
-			Open.RemoveAt(OpenIndex);
+	// Swapping only exchanges the array allocations, the previous map keeps its buffers for the next generation
+	Swap(Generator, State->Pipeline);
+	SpareGeneration = State;
+	CachedMap.Reset();
 
-			if (Close[Close.Num() - 1].NodePosition == Goal->NodePosition)
-			{
-				Routes.Reset(0);
-				FGeneratedNode NodeIterator = *CurrentClose;
-
-				while (NodeIterator.ParentNode != nullptr)
-				{
-					Routes.Add(NodeIterator);
-					NodeIterator = *NodeIterator.ParentNode;
-				}
-				
-				NodeIterator.ParentNode = &Paths[0];
-				Routes.Add(Paths[0]);
-				break;
-			}
+	StartPoint = Generator.StartPoint;
+	EndPoint = Generator.EndPoint;
+	MapVisualizer->MarkMapDirty();
 
-			for (int Index = 0; Index < CurrentClose->ChildNodes.Num(); ++Index)
-			{
-				FGeneratedNode* CurrentChildNode = CurrentClose->ChildNodes[Index];
-				
-				CurrentChildNode->Score = CurrentChildNode->ParentNode->Score + 1;
-
-				FGeneratedNode* SameClosedNode = nullptr;
-				
-
-				for (int CloseIndex = 0; CloseIndex < Close.Num(); ++CloseIndex)
-				{
-					if (Close[CloseIndex].NodePosition == CurrentChildNode->NodePosition)
-					{
-						SameClosedNode = &Close[CloseIndex];
-					}
-				}
-
-				if (SameClosedNode != nullptr)
-				{
-					FGeneratedNode* SameOpenNode = nullptr;
-					int OpenSameIndex = 0;
-
-					for (OpenSameIndex = 0; OpenSameIndex < Open.Num(); ++OpenSameIndex)
-					{
-						if (Open[OpenSameIndex].NodePosition == CurrentChildNode->NodePosition)
-						{
-							SameOpenNode = &Open[OpenSameIndex];
-						}
-					}
-
-					if(SameOpenNode != nullptr)
-					{
-						if (SameOpenNode->Score > CurrentChildNode->Score)
-						{
-							Open[OpenSameIndex].ParentNode = CurrentChildNode->ParentNode;
-						}
-					}
-				 
-				}
-				else
-				{
-					CurrentChildNode->ParentNode = CurrentClose;
-					Open.Add(*CurrentChildNode);
-				}
-			}
-		}
-	}
+	OnMapGenerated.Broadcast(this, true);
 }
 
-void AMapGenerator::DrawDebugGrid()
+void AMapGenerator::UpdateMapChunks(FVector2D FocusPoint)
 {
-	UWorld* World = GetWorld();
-
-	const FVector BoxCenter = FVector(GridExtend / 2.0f, GridExtend / 2.0f, 0.1f);
-	const float CellSize = SphereRadius / FMath::Sqrt(2.0f);
-	const int MaxGridCells = ceil(GridExtend / CellSize);
-
-	DrawDebugBox(World, BoxCenter, BoxCenter, FColor::Green);
-
-	FVector Start = FVector::Zero();
-	FVector End = FVector::Zero();
-	End.X = GridExtend;
-
-	for (int Index = 0; Index < MaxGridCells; ++Index)
+	if (!ChunkStreamer.IsValid())
 	{
-		Start.Y = Index * CellSize;
-		End.Y = Index * CellSize;
-
-		DrawDebugLine(World, Start, End, FColor::Black);
+		UpdateGeneratorSettings();
+		ChunkStreamer = MakeUnique<FMapChunkStreamer>(Generator.Settings, ChunkLoadRadius, SIZE_T(ChunkMemoryBudgetMiB * 1024.0f * 1024.0f));
 	}
 
-	Start = FVector::Zero();
-	End = FVector::Zero();
-	End.Y = GridExtend;
-
-	for (int Index = 0; Index < MaxGridCells; ++Index)
+	if (ChunkStreamer->Update(FocusPoint))
 	{
-		Start.X = Index * CellSize;
-		End.X = Index * CellSize;
-
-		DrawDebugLine(World, Start, End, FColor::Black);
+		MapVisualizer->MarkLayerDirty(EMapVisualizerLayer::Chunks);
 	}
 }
 
-void AMapGenerator::DrawDebugPoisonDisk()
+void AMapGenerator::ResetMapChunks()
 {
-	UWorld* World = GetWorld();
-	UKismetSystemLibrary::FlushPersistentDebugLines(World);
-
-	for (auto It = GeneratedPoints.CreateConstIterator(); It; ++It)
-	{
-		const FVector Position = FVector(It->X, It->Y, 0.0f);
-		DrawDebugSphere(World, Position, 0.1, 4, FColor::Green, true);
-	}
+	ChunkStreamer.Reset();
+	MapVisualizer->MarkLayerDirty(EMapVisualizerLayer::Chunks);
 }
 
-void AMapGenerator::DrawDebugDelaunary()
+#if WITH_EDITOR
+void AMapGenerator::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
-	UWorld* World = GetWorld();
+	Super::PostEditChangeProperty(PropertyChangedEvent);
 
-	for (auto It = Triangles.CreateConstIterator(); It; ++It)
-	{
-		const FVector Vert1 = FVector(It->Vertex1.X, It->Vertex1.Y, 0.0f);
-		const FVector Vert2 = FVector(It->Vertex2.X, It->Vertex2.Y, 0.0f);
-		const FVector Vert3 = FVector(It->Vertex3.X, It->Vertex3.Y, 0.0f);
+	const FName PropertyName = PropertyChangedEvent.GetMemberPropertyName();
 
-		DrawDebugLine(World, Vert1, Vert2, FColor::Blue, true);
-		DrawDebugLine(World, Vert2, Vert3, FColor::Blue, true);
-		DrawDebugLine(World, Vert3, Vert1, FColor::Blue, true);
+	if (PropertyName == GET_MEMBER_NAME_CHECKED(AMapGenerator, StartPoint) || PropertyName == GET_MEMBER_NAME_CHECKED(AMapGenerator, EndPoint))
+	{
+		UpdateStartEndPoints();
 	}
-
-	for (auto It = Edges.CreateConstIterator(); It; ++It)
+	else if (PropertyName == GET_MEMBER_NAME_CHECKED(AMapGenerator, Seed) || PropertyName == GET_MEMBER_NAME_CHECKED(AMapGenerator, GridExtend)
+		|| PropertyName == GET_MEMBER_NAME_CHECKED(AMapGenerator, SphereRadius) || PropertyName == GET_MEMBER_NAME_CHECKED(AMapGenerator, Iterations)
+		|| PropertyName == GET_MEMBER_NAME_CHECKED(AMapGenerator, NumSampleBeforeRejection) || PropertyName == GET_MEMBER_NAME_CHECKED(AMapGenerator, ChunkLoadRadius)
+		|| PropertyName == GET_MEMBER_NAME_CHECKED(AMapGenerator, ChunkMemoryBudgetMiB))
 	{
-		const FVector Vert1 = FVector(It->StartPoint.X, It->StartPoint.Y, 0.0f);
-		const FVector Vert2 = FVector(It->EndPoint.X, It->EndPoint.Y, 0.0f);
-
-		DrawDebugLine(World, Vert1, Vert2, FColor::Blue, true);
+		// The streamed chunks are generated again with the new settings
+		ResetMapChunks();
+		MapVisualizer->MarkLayerDirty(EMapVisualizerLayer::Grid);
 	}
+
+	UpdateVisualizerLayers();
 }
+#endif
 
-void AMapGenerator::DrawDebugPathGenerated()
+void AMapGenerator::UpdateVisualizerLayers()
 {
-	UWorld* World = GetWorld();
-
-	UKismetSystemLibrary::FlushPersistentDebugLines(World);
-
-	for (int Index = 0; Index < Paths.Num(); ++Index)
-	{
-		int ColorValueR = Random.RandRange(0, 255);
-		int ColorValueG = Random.RandRange(0, 255);
-		int ColorValueB = Random.RandRange(0, 255);
-
-		FColor RandomColor = FColor(ColorValueR, ColorValueG, ColorValueB);
-
-		FVector PathPoint = FVector(Paths[Index].NodePosition.X, Paths[Index].NodePosition.Y, 0.0f);
-
-		DrawDebugSphere(World, PathPoint, 0.1f, 10, RandomColor, true);
-
-		for (int LinkedIndex = 0; LinkedIndex < Paths[Index].ChildNodes.Num(); ++LinkedIndex)
-		{
-			FVector NexPathPoint = FVector(Paths[Index].ChildNodes[LinkedIndex]->NodePosition.X, Paths[Index].ChildNodes[LinkedIndex]->NodePosition.Y, 0.0f);
-
-			DrawDebugLine(World, PathPoint, NexPathPoint, RandomColor, true);
-		}
-	}
+	MapVisualizer->SetLayerVisible(EMapVisualizerLayer::Grid, bDebugGrid);
+	MapVisualizer->SetLayerVisible(EMapVisualizerLayer::Points, bDebugPoisonDisk);
+	MapVisualizer->SetLayerVisible(EMapVisualizerLayer::Triangulation, bDebugDelaunary);
+	MapVisualizer->SetLayerVisible(EMapVisualizerLayer::Paths, bDebugGeneratedPath);
+	MapVisualizer->SetLayerVisible(EMapVisualizerLayer::Route, bDebugGeneratedPath);
+	MapVisualizer->SetLayerVisible(EMapVisualizerLayer::Chunks, bDebugMapChunks);
+}
 
-	for (int Index = Routes.Num() - 1; Index >= 0; --Index)
-	{
-		FVector PathPoint = FVector(Routes[Index].NodePosition.X, Routes[Index].NodePosition.Y, 1.0f);
-		DrawDebugSphere(World, PathPoint, 0.1f, 10, FColor::Black, true);
+void AMapGenerator::DrawDebugGrid()
+{
+	bDebugGrid = true;
+	MapVisualizer->MarkLayerDirty(EMapVisualizerLayer::Grid);
+	UpdateVisualizerLayers();
+}
 
-		if (Index > 0)
-		{
-			FVector PrevPathPoint = FVector(Routes[Index - 1].NodePosition.X, Routes[Index - 1].NodePosition.Y, 1.0f);
-			DrawDebugLine(World, PathPoint, PrevPathPoint, FColor::Black, true);
-		}
+void AMapGenerator::DrawDebugPoisonDisk()
+{
+	bDebugPoisonDisk = true;
+	MapVisualizer->MarkLayerDirty(EMapVisualizerLayer::Points);
+	UpdateVisualizerLayers();
+}
 
-	}
+void AMapGenerator::DrawDebugDelaunary()
+{
+	bDebugDelaunary = true;
+	MapVisualizer->MarkLayerDirty(EMapVisualizerLayer::Triangulation);
+	UpdateVisualizerLayers();
+}
 
+void AMapGenerator::DrawDebugPathGenerated()
+{
+	bDebugGeneratedPath = true;
+	MapVisualizer->MarkLayerDirty(EMapVisualizerLayer::Paths);
+	MapVisualizer->MarkLayerDirty(EMapVisualizerLayer::Route);
+	UpdateVisualizerLayers();
+}
 
+void AMapGenerator::DrawDebugMapChunks()
+{
+	bDebugMapChunks = true;
+	MapVisualizer->MarkLayerDirty(EMapVisualizerLayer::Chunks);
+	UpdateVisualizerLayers();
 }
 
 // Called every frame
@@ -603,28 +487,16 @@ void AMapGenerator::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	if (bDebugGrid)
+	if (bStreamMapChunks)
 	{
-		DrawDebugGrid();
-	}
-	
-	if (bDebugPoisonDisk)
-	{
-		DrawDebugPoisonDisk();
-		bDebugPoisonDisk = false;
-	}
-	
-	if (bDebugDelaunary)
-	{
-		DrawDebugDelaunary();
-		bDebugDelaunary = false;
+		if (const APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(this, 0))
+		{
+			const FVector PlayerLocation = PlayerPawn->GetActorLocation();
+			UpdateMapChunks(FVector2D(PlayerLocation.X, PlayerLocation.Y));
+		}
 	}
 
-	if (bDebugGeneratedPath)
-	{
-		DrawDebugPathGenerated();
-		bDebugGeneratedPath = false;
-	}
+	UpdateVisualizerLayers();
 }
 
 
@@ -1,14 +0,0 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
-
-#include "Structs/GeneratedEdge.h"
-
-
-FGeneratedEdge::FGeneratedEdge()
-{
-}
-
-FGeneratedEdge::FGeneratedEdge(FVector2D &v1, FVector2D &v2):
-	StartPoint(v1), EndPoint(v2)
-{
-}
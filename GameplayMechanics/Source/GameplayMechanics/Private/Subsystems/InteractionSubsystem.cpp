@@ -0,0 +1,452 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/InteractionSubsystem.h"
+#include "GameFramework/Actor.h"
+#include "Components/ActorComponent.h"
+
+void UInteractionSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	SelectionInterval = 0.1f;
+	InteractableCellSize = 400.f;
+	TimeSinceSelection = 0.f;
+}
+
+TStatId UInteractionSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UInteractionSubsystem, STATGROUP_Tickables);
+}
+
+IInteractionInterface* UInteractionSubsystem::FindInteraction(AActor* Actor)
+{
+	if (Actor == nullptr)
+	{
+		return nullptr;
+	}
+
+	if (IInteractionInterface* Interaction = Cast<IInteractionInterface>(Actor))
+	{
+		return Interaction;
+	}
+
+	for (UActorComponent* Component : Actor->GetComponents())
+	{
+		if (IInteractionInterface* Interaction = Cast<IInteractionInterface>(Component))
+		{
+			return Interaction;
+		}
+	}
+
+	return nullptr;
+}
+
+UInteractionSubsystem::FInteractionTarget UInteractionSubsystem::MakeTarget(AActor* Actor)
+{
+	FInteractionTarget Target;
+	Target.Actor = Actor;
+
+	if (IInteractionInterface* Interaction = FindInteraction(Actor))
+	{
+		Target.Interaction = TWeakInterfacePtr<IInteractionInterface>(*Interaction);
+	}
+
+	return Target;
+}
+
+UInteractionSubsystem::FInteractionTarget UInteractionSubsystem::ResolveTarget(AActor* Actor)
+{
+	if (const int32* Index = InteractableIndices.Find(Actor))
+	{
+		return Interactables[*Index].Target;
+	}
+
+	if (const FInteractionTarget* Target = ResolvedTargets.Find(Actor))
+	{
+		return *Target;
+	}
+
+	// Only the actors overlapping an interactor get here, the destroyed ones are dropped whenever the cache doubles
+	if (ResolvedTargets.Num() >= ResolvedTargetsPruneSize)
+	{
+		for (TMap<TObjectKey<AActor>, FInteractionTarget>::TIterator It(ResolvedTargets); It; ++It)
+		{
+			if (!It.Value().Actor.IsValid())
+			{
+				It.RemoveCurrent();
+			}
+		}
+
+		ResolvedTargetsPruneSize = FMath::Max(64, 2 * ResolvedTargets.Num());
+	}
+
+	return ResolvedTargets.Add(Actor, MakeTarget(Actor));
+}
+
+UInteractionSubsystem::FInteractor* UInteractionSubsystem::FindInteractor(const USceneComponent* Origin)
+{
+	return Interactors.FindByPredicate([Origin](const FInteractor& Interactor) { return Interactor.Origin.Get() == Origin; });
+}
+
+const UInteractionSubsystem::FInteractor* UInteractionSubsystem::FindInteractor(const USceneComponent* Origin) const
+{
+	return Interactors.FindByPredicate([Origin](const FInteractor& Interactor) { return Interactor.Origin.Get() == Origin; });
+}
+
+void UInteractionSubsystem::AddCandidate(USceneComponent* Origin, AActor* Candidate)
+{
+	if (Origin == nullptr || Candidate == nullptr)
+	{
+		return;
+	}
+
+	const FInteractionTarget Target = ResolveTarget(Candidate);
+
+	if (!Target.Interaction.IsValid())
+	{
+		return;
+	}
+
+	FInteractor* Interactor = FindInteractor(Origin);
+
+	if (Interactor == nullptr)
+	{
+		Interactor = &Interactors.AddDefaulted_GetRef();
+		Interactor->Origin = Origin;
+	}
+
+	if (!Interactor->Candidates.ContainsByPredicate([Candidate](const FInteractionTarget& Other) { return Other.Actor.Get() == Candidate; }))
+	{
+		Interactor->Candidates.Add(Target);
+	}
+
+	// The first candidate is selected right away, the closest one is picked on the next selection
+	if (!Interactor->Selected.Actor.IsValid())
+	{
+		SetSelected(*Interactor, Target);
+	}
+}
+
+void UInteractionSubsystem::RemoveCandidate(USceneComponent* Origin, AActor* Candidate)
+{
+	FInteractor* Interactor = FindInteractor(Origin);
+
+	if (Interactor == nullptr)
+	{
+		return;
+	}
+
+	const int32 Index = Interactor->Candidates.IndexOfByPredicate([Candidate](const FInteractionTarget& Other) { return Other.Actor.Get() == Candidate; });
+
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	Interactor->Candidates.RemoveAtSwap(Index, 1, false);
+
+	if (Interactor->Selected.Actor.Get() == Candidate)
+	{
+		SelectClosestCandidate(*Interactor);
+	}
+}
+
+void UInteractionSubsystem::AddIndexedInteractor(USceneComponent* Origin, float MaxDistance, float MaxAngle)
+{
+	if (Origin == nullptr)
+	{
+		return;
+	}
+
+	FInteractor* Interactor = FindInteractor(Origin);
+
+	if (Interactor == nullptr)
+	{
+		Interactor = &Interactors.AddDefaulted_GetRef();
+		Interactor->Origin = Origin;
+	}
+
+	Interactor->bIndexed = true;
+	Interactor->MaxDistance = MaxDistance;
+	Interactor->MaxAngle = MaxAngle;
+}
+
+void UInteractionSubsystem::RemoveInteractor(USceneComponent* Origin)
+{
+	const int32 Index = Interactors.IndexOfByPredicate([Origin](const FInteractor& Interactor) { return Interactor.Origin.Get() == Origin; });
+
+	if (Index != INDEX_NONE)
+	{
+		SetSelected(Interactors[Index], FInteractionTarget());
+		Interactors.RemoveAtSwap(Index, 1, false);
+	}
+}
+
+AActor* UInteractionSubsystem::GetSelectedActor(const USceneComponent* Origin) const
+{
+	const FInteractor* Interactor = FindInteractor(Origin);
+	return Interactor != nullptr ? Interactor->Selected.Actor.Get() : nullptr;
+}
+
+IInteractionInterface* UInteractionSubsystem::GetSelectedInteraction(const USceneComponent* Origin) const
+{
+	const FInteractor* Interactor = FindInteractor(Origin);
+	return Interactor != nullptr ? Interactor->Selected.Interaction.Get() : nullptr;
+}
+
+void UInteractionSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	TimeSinceSelection += DeltaTime;
+
+	if (TimeSinceSelection < SelectionInterval)
+	{
+		return;
+	}
+
+	TimeSinceSelection = 0.f;
+
+	for (int32 Index = Interactors.Num() - 1; Index >= 0; --Index)
+	{
+		FInteractor& Interactor = Interactors[Index];
+
+		if (!Interactor.Origin.IsValid() || (!Interactor.bIndexed && Interactor.Candidates.Num() == 0))
+		{
+			Interactors.RemoveAtSwap(Index, 1, false);
+		}
+		else if (Interactor.bIndexed)
+		{
+			const USceneComponent* Origin = Interactor.Origin.Get();
+			const FInteractionTarget* Best = FindBestTarget(Origin->GetComponentLocation(), Origin->GetForwardVector(), Interactor.MaxDistance, Interactor.MaxAngle);
+			SetSelected(Interactor, Best != nullptr ? *Best : FInteractionTarget());
+		}
+		else if (Interactor.Candidates.Num() > 1)
+		{
+			SelectClosestCandidate(Interactor);
+		}
+	}
+}
+
+void UInteractionSubsystem::SelectClosestCandidate(FInteractor& Interactor)
+{
+	const FVector OriginLocation = Interactor.Origin->GetComponentLocation();
+
+	int32 Closest = INDEX_NONE;
+	double ClosestDistanceSquared = TNumericLimits<double>::Max();
+
+	for (int32 Index = Interactor.Candidates.Num() - 1; Index >= 0; --Index)
+	{
+		const AActor* Candidate = Interactor.Candidates[Index].Actor.Get();
+
+		if (Candidate == nullptr)
+		{
+			Interactor.Candidates.RemoveAtSwap(Index, 1, false);
+
+			// The swapped in candidate was already visited
+			if (Closest == Interactor.Candidates.Num())
+			{
+				Closest = Index;
+			}
+
+			continue;
+		}
+
+		const double DistanceSquared = FVector::DistSquared(Candidate->GetActorLocation(), OriginLocation);
+
+		// The current selection wins ties so it is not cancelled for an equally close candidate
+		if (DistanceSquared < ClosestDistanceSquared || (DistanceSquared == ClosestDistanceSquared && Candidate == Interactor.Selected.Actor.Get()))
+		{
+			ClosestDistanceSquared = DistanceSquared;
+			Closest = Index;
+		}
+	}
+
+	SetSelected(Interactor, Closest != INDEX_NONE ? Interactor.Candidates[Closest] : FInteractionTarget());
+}
+
+void UInteractionSubsystem::SetSelected(FInteractor& Interactor, const FInteractionTarget& Candidate)
+{
+	if (Interactor.Selected.Actor.Get() == Candidate.Actor.Get())
+	{
+		return;
+	}
+
+	if (IInteractionInterface* Interaction = Interactor.Selected.Interaction.Get())
+	{
+		Interaction->CancelInteraction();
+	}
+
+	Interactor.Selected = Candidate;
+
+	if (IInteractionInterface* Interaction = Candidate.Interaction.Get())
+	{
+		Interaction->PrepareInteraction();
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Interactable grid
+
+void UInteractionSubsystem::SetInteractableCellSize(float CellSize)
+{
+	InteractableCellSize = FMath::Max(CellSize, MinInteractableCellSize);
+
+	InteractableCells.Reset();
+
+	for (TSparseArray<FIndexedInteractable>::TIterator It(Interactables); It; ++It)
+	{
+		It->Cell = GetInteractableCell(It->Location);
+		InteractableCells.FindOrAdd(It->Cell).Add(It.GetIndex());
+	}
+}
+
+FIntPoint UInteractionSubsystem::GetInteractableCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / InteractableCellSize), FMath::FloorToInt(Location.Y / InteractableCellSize));
+}
+
+void UInteractionSubsystem::RegisterInteractable(AActor* Actor)
+{
+	if (Actor == nullptr || InteractableIndices.Contains(Actor))
+	{
+		return;
+	}
+
+	FIndexedInteractable Interactable;
+	Interactable.Target = MakeTarget(Actor);
+
+	if (!Interactable.Target.Interaction.IsValid())
+	{
+		return;
+	}
+
+	Interactable.Location = Actor->GetActorLocation();
+	Interactable.Cell = GetInteractableCell(Interactable.Location);
+
+	// Static interactables never broadcast it, so only the ones that do move cost anything
+	if (USceneComponent* Root = Actor->GetRootComponent())
+	{
+		Interactable.TransformUpdatedHandle = Root->TransformUpdated.AddUObject(this, &UInteractionSubsystem::HandleInteractableMoved);
+	}
+
+	const int32 Index = Interactables.Add(Interactable);
+	InteractableIndices.Add(Actor, Index);
+	ResolvedTargets.Remove(Actor);
+	InteractableCells.FindOrAdd(Interactable.Cell).Add(Index);
+}
+
+void UInteractionSubsystem::UnregisterInteractable(AActor* Actor)
+{
+	int32 Index = INDEX_NONE;
+
+	if (!InteractableIndices.RemoveAndCopyValue(Actor, Index))
+	{
+		return;
+	}
+
+	const FIndexedInteractable& Interactable = Interactables[Index];
+
+	if (USceneComponent* Root = Actor->GetRootComponent())
+	{
+		Root->TransformUpdated.Remove(Interactable.TransformUpdatedHandle);
+	}
+
+	TArray<int32>& Cell = InteractableCells.FindChecked(Interactable.Cell);
+	Cell.RemoveSingleSwap(Index, false);
+
+	if (Cell.Num() == 0)
+	{
+		InteractableCells.Remove(Interactable.Cell);
+	}
+
+	Interactables.RemoveAt(Index);
+
+	// Indexed interactors select again on the next selection, this one may be gone by then
+	for (FInteractor& Interactor : Interactors)
+	{
+		if (Interactor.bIndexed && Interactor.Selected.Actor.Get() == Actor)
+		{
+			SetSelected(Interactor, FInteractionTarget());
+		}
+	}
+}
+
+void UInteractionSubsystem::HandleInteractableMoved(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	const int32* Index = InteractableIndices.Find(UpdatedComponent->GetOwner());
+
+	if (Index == nullptr)
+	{
+		return;
+	}
+
+	FIndexedInteractable& Interactable = Interactables[*Index];
+	Interactable.Location = UpdatedComponent->GetComponentLocation();
+
+	const FIntPoint Cell = GetInteractableCell(Interactable.Location);
+
+	if (Cell != Interactable.Cell)
+	{
+		TArray<int32>& PreviousCell = InteractableCells.FindChecked(Interactable.Cell);
+		PreviousCell.RemoveSingleSwap(*Index, false);
+
+		if (PreviousCell.Num() == 0)
+		{
+			InteractableCells.Remove(Interactable.Cell);
+		}
+
+		Interactable.Cell = Cell;
+		InteractableCells.FindOrAdd(Cell).Add(*Index);
+	}
+}
+
+AActor* UInteractionSubsystem::FindBestInteractable(const FVector& Location, const FVector& Direction, float MaxDistance, float MaxAngle) const
+{
+	const FInteractionTarget* Best = FindBestTarget(Location, Direction, MaxDistance, MaxAngle);
+	return Best != nullptr ? Best->Actor.Get() : nullptr;
+}
+
+const UInteractionSubsystem::FInteractionTarget* UInteractionSubsystem::FindBestTarget(const FVector& Location, const FVector& Direction, float MaxDistance, float MaxAngle) const
+{
+	const FIntPoint MinCell = GetInteractableCell(Location - FVector(MaxDistance));
+	const FIntPoint MaxCell = GetInteractableCell(Location + FVector(MaxDistance));
+	const FVector Forward = Direction.GetSafeNormal();
+	const double MinFacing = FMath::Cos(FMath::DegreesToRadians(FMath::Clamp(MaxAngle, 0.f, 180.f)));
+
+	const FInteractionTarget* Best = nullptr;
+	double BestDistanceSquared = FMath::Square(double(MaxDistance));
+
+	for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+	{
+		for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+		{
+			const TArray<int32>* Cell = InteractableCells.Find(FIntPoint(X, Y));
+
+			if (Cell == nullptr)
+			{
+				continue;
+			}
+
+			for (const int32 Index : *Cell)
+			{
+				const FIndexedInteractable& Interactable = Interactables[Index];
+				const FVector Offset = Interactable.Location - Location;
+				const double DistanceSquared = Offset.SizeSquared();
+
+				if (DistanceSquared > BestDistanceSquared || (Offset | Forward) < MinFacing * FMath::Sqrt(DistanceSquared))
+				{
+					continue;
+				}
+
+				if (Interactable.Target.Actor.IsValid())
+				{
+					BestDistanceSquared = DistanceSquared;
+					Best = &Interactable.Target;
+				}
+			}
+		}
+	}
+
+	return Best;
+}
@@ -0,0 +1,90 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/WallDetectionSubsystem.h"
+#include "GameplayMechanicsCharacter.h"
+#include "Engine/World.h"
+
+void UWallDetectionSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	MaxTracesPerFrame = 0;
+	WallTraceDelegate.BindUObject(this, &UWallDetectionSubsystem::HandleWallTraceDone);
+}
+
+TStatId UWallDetectionSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWallDetectionSubsystem, STATGROUP_Tickables);
+}
+
+void UWallDetectionSubsystem::RequestWallTrace(AGameplayMechanicsCharacter* Character)
+{
+	PendingCharacters.Add(Character);
+}
+
+void UWallDetectionSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	UWorld* World = GetWorld();
+
+	// Results are delivered at the start of the frame, a trace still here was dropped and is asked again first
+	for (int32 Index = RunningTraces.Num() - 1; Index >= 0; --Index)
+	{
+		if (RunningTraces[Index].Character.IsValid())
+		{
+			PendingCharacters.Insert(RunningTraces[Index].Character, 0);
+		}
+	}
+
+	RunningTraces.Reset();
+
+	const int32 NumTraces = MaxTracesPerFrame > 0 ? FMath::Min(MaxTracesPerFrame, PendingCharacters.Num()) : PendingCharacters.Num();
+
+	if (NumTraces == 0)
+	{
+		return;
+	}
+
+	const FCollisionObjectQueryParams ObjectParams(ECC_WorldStatic);
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(WallDetection));
+
+	for (int32 Index = 0; Index < NumTraces; ++Index)
+	{
+		AGameplayMechanicsCharacter* Character = PendingCharacters[Index].Get();
+
+		if (Character == nullptr)
+		{
+			continue;
+		}
+
+		FVector Start;
+		FVector End;
+		Character->GetWallTrace(Start, End);
+
+		FWallTrace& WallTrace = RunningTraces.AddDefaulted_GetRef();
+		WallTrace.Character = Character;
+		WallTrace.Handle = World->AsyncLineTraceByObjectType(EAsyncTraceType::Single, Start, End, ObjectParams, QueryParams, &WallTraceDelegate, RunningTraces.Num() - 1);
+	}
+
+	PendingCharacters.RemoveAt(0, NumTraces, false);
+}
+
+void UWallDetectionSubsystem::HandleWallTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceData)
+{
+	const int32 Index = int32(TraceData.UserData);
+
+	if (!RunningTraces.IsValidIndex(Index) || RunningTraces[Index].Handle != TraceHandle)
+	{
+		return;
+	}
+
+	AGameplayMechanicsCharacter* Character = RunningTraces[Index].Character.Get();
+	RunningTraces[Index].Character.Reset();
+
+	if (Character != nullptr)
+	{
+		const bool bHit = TraceData.OutHits.Num() > 0 && TraceData.OutHits[0].bBlockingHit;
+		Character->OnWallTraceDone(bHit ? &TraceData.OutHits[0] : nullptr);
+	}
+}
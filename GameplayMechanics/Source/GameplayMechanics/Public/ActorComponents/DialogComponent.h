@@ -21,6 +21,8 @@ protected:
 	// Called when the game starts
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 public:	
 	// Called every frame
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
@@ -48,6 +50,10 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "InteractableBox")
 	class UBoxComponent* BoxTrigger;
 
+	/** Found through the overlaps of BoxTrigger, otherwise only through the interaction subsystem grid */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "InteractableBox")
+	bool bUseTriggerOverlap;
+
 private:
 
 	bool bDialogTriggered;
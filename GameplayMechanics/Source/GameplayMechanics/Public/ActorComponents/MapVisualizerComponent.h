@@ -0,0 +1,70 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/LineBatchComponent.h"
+#include "Components/SceneComponent.h"
+#include "MapVisualizerComponent.generated.h"
+
+UENUM(BlueprintType)
+enum class EMapVisualizerLayer : uint8
+{
+	Grid,
+	Points,
+	Triangulation,
+	Paths,
+	Route,
+	Chunks,
+	Num UMETA(Hidden)
+};
+
+/**
+ * Draws the map of the owning AMapGenerator with one line batch per layer. A layer is built into its batch once, as a single
+ * render proxy, and only built again when the map is marked dirty, instead of issuing a debug primitive per element.
+ */
+UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
+class GAMEPLAYMECHANICS_API UMapVisualizerComponent : public USceneComponent
+{
+	GENERATED_BODY()
+
+public:
+	// Sets default values for this component's properties
+	UMapVisualizerComponent();
+
+	virtual void OnRegister() override;
+	virtual void OnUnregister() override;
+
+	// Builds the layers marked dirty, the component only ticks while there are some
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	UFUNCTION(BlueprintCallable)
+	void SetLayerVisible(EMapVisualizerLayer Layer, bool bVisible);
+
+	UFUNCTION(BlueprintPure)
+	bool IsLayerVisible(EMapVisualizerLayer Layer) const;
+
+	// The map changed, visible layers are built again on the next tick and hidden ones once shown
+	UFUNCTION(BlueprintCallable)
+	void MarkMapDirty();
+
+	UFUNCTION(BlueprintCallable)
+	void MarkLayerDirty(EMapVisualizerLayer Layer);
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Map Visualizer")
+	float PointSize;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Map Visualizer")
+	float RouteThickness;
+
+private:
+	void BuildLayer(EMapVisualizerLayer Layer, TArray<FBatchedLine>& OutLines, TArray<FBatchedPoint>& OutPoints) const;
+
+	static constexpr int32 NumLayers = int32(EMapVisualizerLayer::Num);
+
+	UPROPERTY(Transient)
+	TArray<ULineBatchComponent*> LayerBatches;
+
+	bool bLayerVisible[NumLayers];
+	bool bLayerDirty[NumLayers];
+};
@@ -0,0 +1,40 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "GenerateMapAsyncAction.generated.h"
+
+class AMapGenerator;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FGenerateMapAsyncActionPin, AMapGenerator*, MapGenerator);
+
+/**
+ * Latent node running AMapGenerator::GenerateMapAsync, its output pins fire once the new map replaced the previous one
+ * or once the generation was cancelled.
+ */
+UCLASS()
+class GAMEPLAYMECHANICS_API UGenerateMapAsyncAction : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true"), Category = "Map Generation")
+	static UGenerateMapAsyncAction* GenerateMap(AMapGenerator* MapGenerator);
+
+	virtual void Activate() override;
+
+	UPROPERTY(BlueprintAssignable)
+	FGenerateMapAsyncActionPin Completed;
+
+	UPROPERTY(BlueprintAssignable)
+	FGenerateMapAsyncActionPin Cancelled;
+
+private:
+	UFUNCTION()
+	void HandleMapGenerated(AMapGenerator* InMapGenerator, bool bCompleted);
+
+	UPROPERTY()
+	AMapGenerator* MapGenerator;
+};
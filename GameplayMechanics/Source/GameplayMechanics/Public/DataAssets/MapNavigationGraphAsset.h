@@ -0,0 +1,48 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Navigation/MapNavigationGraph.h"
+#include "MapNavigationGraphAsset.generated.h"
+
+/**
+ * Navigation graph exported from a generated map, saved with the asset so AI and spawners can query it without the
+ * AMapGenerator that generated it. The queries only read the graph and can run from any thread, as long as it is not
+ * exported again meanwhile.
+ */
+UCLASS(BlueprintType)
+class GAMEPLAYMECHANICS_API UMapNavigationGraphAsset : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Serialize(FArchive& Ar) override;
+
+	// Replaces the graph with the path nodes of Map
+	void Build(const FMapGenerationView& Map);
+
+	const FMapNavigationGraph& GetGraph() const
+	{
+		return Graph;
+	}
+
+	UFUNCTION(BlueprintPure, Category = "Map Navigation")
+	int32 GetNumNodes() const;
+
+	UFUNCTION(BlueprintPure, Category = "Map Navigation")
+	FVector2D GetNodePosition(int32 Node) const;
+
+	// Closest node to Position, -1 when the graph is empty
+	UFUNCTION(BlueprintPure, Category = "Map Navigation")
+	int32 FindNearestNode(FVector2D Position) const;
+
+	// Node indices from Start to Goal, false when Goal can not be reached. Allocates a search per call, C++ callers
+	// running many searches keep their own FRouteSearch and call FindRoute on GetGraph instead.
+	UFUNCTION(BlueprintCallable, Category = "Map Navigation")
+	bool FindRoute(int32 Start, int32 Goal, TArray<int32>& OutRoute) const;
+
+private:
+	FMapNavigationGraph Graph;
+};
@@ -20,6 +20,8 @@ protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 public:	
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
@@ -35,4 +37,8 @@ public:
 
 	UPROPERTY(VisibleDefaultsOnly)
 	class UWidgetComponent* InteractButtonWidget;
+
+	/** Found through the overlaps of BoxTrigger, otherwise only through the interaction subsystem grid */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Interaction")
+	bool bUseTriggerOverlap;
 };
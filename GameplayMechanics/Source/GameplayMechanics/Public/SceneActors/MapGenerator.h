@@ -4,11 +4,19 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
-#include "Structs/GeneratedEdge.h"
-#include "Structs/GeneratedNode.h"
-#include "Structs/GeneratedTriangles.h"
+#include "MapGenerationPipeline.h"
+#include "Cache/MapGenerationCache.h"
+#include "Routing/BatchRouteSearch.h"
+#include "Streaming/MapChunkStreamer.h"
 #include "MapGenerator.generated.h"
 
+struct FMapGenerationAsyncState;
+class UMapVisualizerComponent;
+class UMapNavigationGraphAsset;
+
+// bCompleted is false when the generation was cancelled
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnMapGenerated, AMapGenerator*, MapGenerator, bool, bCompleted);
+
 UCLASS()
 class GAMEPLAYMECHANICS_API AMapGenerator : public AActor
 {
@@ -21,12 +29,14 @@ public:
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	
 private:
 
+	// Running a stage or editing the map cancels the generation in flight, which would replace the result once done
 	UFUNCTION(BlueprintCallable)
 	void MyPoisonDiskSamplingAlgorithm();
-	bool IsMyCandidateValid(FVector2D Candidate, FVector2D SampleRegionSize, float CellSize, TArray<int> Grid);
 	UFUNCTION(BlueprintCallable)
 	void DelaunaryTriangulation();
 	UFUNCTION(BlueprintCallable)
@@ -35,7 +45,19 @@ private:
 	UFUNCTION(BlueprintCallable)
 	void FindRoutes();
 
+	// Edits of the generated map, only the triangles and paths around the edited point are rebuilt
+	UFUNCTION(BlueprintCallable)
+	int32 AddMapPoint(FVector2D Position);
+	UFUNCTION(BlueprintCallable)
+	bool RemoveMapPoint(int32 PointIndex);
+	UFUNCTION(BlueprintCallable)
+	bool MoveMapPoint(int32 PointIndex, FVector2D NewPosition);
 
+	// Moves the generated start and end points to StartPoint and EndPoint
+	UFUNCTION(BlueprintCallable)
+	void UpdateStartEndPoints();
+
+	// Show the debug layers, they stay drawn and follow the map until their flag is cleared
 	UFUNCTION(BlueprintCallable)
 	void DrawDebugGrid();
 	UFUNCTION(BlueprintCallable)
@@ -46,10 +68,89 @@ private:
 	UFUNCTION(BlueprintCallable)
 	void DrawDebugPathGenerated();
 
+	UFUNCTION(BlueprintCallable)
+	void DrawDebugMapChunks();
+
+	// Copies the editable properties into the pipeline settings before running a stage
+	void UpdateGeneratorSettings();
+
+	// Shows the visualizer layers of the debug flags
+	void UpdateVisualizerLayers();
+
+	// Reads the map of the current settings from the cache in place, when bUseMapCache is set and it is cached
+	bool LoadCachedMap();
+
+	// Copies a map loaded from the cache into Generator, before running a stage or editing it
+	void MaterializeCachedMap();
+
+	FString GetMapCacheDirectory() const;
+
+	// Swaps the map generated in the background with Generator, on the game thread
+	void FinishMapGeneration(const TSharedRef<FMapGenerationAsyncState, ESPMode::ThreadSafe>& State);
+
 public:	
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
 
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	// Runs every stage, or loads the map from the cache when it was already generated with the same settings.
+	// Cancels the generation in flight.
+	UFUNCTION(BlueprintCallable)
+	void GenerateMap();
+
+	// Runs every stage on background threads into a second pipeline, swapped with Generator on the game thread once done,
+	// so the game thread never sees a partially generated map. Starting again cancels the generation in flight.
+	// Uses the map cache like GenerateMap: a cached map is loaded right away and OnMapGenerated broadcast before returning,
+	// otherwise the generated map is saved from the background threads.
+	UFUNCTION(BlueprintCallable)
+	void GenerateMapAsync();
+
+	UFUNCTION(BlueprintCallable)
+	void CancelMapGeneration();
+
+	// Generates the chunks of the unbounded map around FocusPoint and evicts the least recently used ones over the budget
+	UFUNCTION(BlueprintCallable)
+	void UpdateMapChunks(FVector2D FocusPoint);
+
+	// Drops every chunk, the next update generates them again with the current settings
+	UFUNCTION(BlueprintCallable)
+	void ResetMapChunks();
+
+	// Routes between path nodes of the generated map, found on NumRouteThreads threads. The route of query Q is
+	// OutRouteNodes[OutRouteOffsets[Q], OutRouteOffsets[Q + 1]), empty when the goal can not be reached.
+	// X of every query is the start node and Y the goal node.
+	UFUNCTION(BlueprintCallable)
+	void FindMapRoutes(const TArray<FIntPoint>& Queries, TArray<int32>& OutRouteOffsets, TArray<int32>& OutRouteNodes);
+
+	// Same for C++ callers, without converting the queries and copying the routes
+	void FindMapRouteBatch(TConstArrayView<FRouteQuery> Queries, FRouteBatchResult& OutRoutes);
+
+	// Writes the path nodes of the generated map into NavigationGraph, which is saved with it
+	UFUNCTION(CallInEditor, BlueprintCallable, Category = "Map Navigation")
+	void ExportNavigationGraph();
+
+	// Generated map, read from the cached file when it was loaded from the cache
+	FMapGenerationView GetMapView() const;
+
+	// Null until the first chunk update
+	const FMapChunkStreamer* GetMapChunks() const
+	{
+		return ChunkStreamer.Get();
+	}
+
+	UFUNCTION(BlueprintPure)
+	bool IsGeneratingMap() const;
+
+	// Fraction of the stages done by the generation in flight, 1 when there is none
+	UFUNCTION(BlueprintPure)
+	float GetMapGenerationProgress() const;
+
+	UPROPERTY(BlueprintAssignable)
+	FOnMapGenerated OnMapGenerated;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Poison Disk Sampling Grid Generator")
 	int Seed;
 
@@ -68,6 +169,35 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Poison Disk Sampling Grid Generator")
 	bool bCheckWellGenerated;
 
+	// Loads the maps generated by GenerateMap and GenerateMapAsync from disk, and saves the ones that were not cached yet
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Map Cache")
+	bool bUseMapCache;
+
+	// Relative to the project Saved directory
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Map Cache")
+	FString MapCacheDirectory;
+
+	// Streams chunks of GridExtend around the first player every tick instead of generating a single square
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Map Chunks")
+	bool bStreamMapChunks;
+
+	// Chunks generated on every side of the chunk containing the focus point
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Map Chunks", meta = (ClampMin = "0"))
+	int ChunkLoadRadius;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Map Chunks", meta = (ClampMin = "0"))
+	float ChunkMemoryBudgetMiB;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Map Navigation")
+	UMapNavigationGraphAsset* NavigationGraph;
+
+	// Threads answering the queries of FindMapRoutes, 0 uses every core
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Map Routes", meta = (ClampMin = "0"))
+	int NumRouteThreads;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Debug Map Generator")
+	UMapVisualizerComponent* MapVisualizer;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Map Generator")
 	bool bDebugGrid;
 
@@ -80,16 +210,11 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Map Generator")
 	bool bDebugGeneratedPath;
 
-	TArray<FVector2D> GeneratedPoints;
-
-	TArray<int> Grid;
-
-	TArray<FGeneratedTriangle> Triangles;
-
-	TArray<FGeneratedEdge> Edges;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Map Generator")
+	bool bDebugMapChunks;
 
-	TArray<FGeneratedNode> Paths;
-	TArray<FGeneratedNode> Routes;
+	// Owns the generated points, triangles, edges, paths and routes, unless CachedMap holds them
+	FMapGenerationPipeline Generator;
 
 	FRandomStream Random;
 
@@ -104,5 +229,20 @@ private:
 	UPROPERTY(EditAnywhere)
 	FVector2D EndPoint;
 
+	// Generation in flight, and the buffers of the map it replaced last, reused by the next one
+	TSharedPtr<FMapGenerationAsyncState, ESPMode::ThreadSafe> AsyncGeneration;
+	TSharedPtr<FMapGenerationAsyncState, ESPMode::ThreadSafe> SpareGeneration;
+
+	// Map loaded from the cache, read in place until a stage or an edit needs it in Generator
+	TUniquePtr<FMapGenerationCacheFile> CachedMap;
+
+	// Chunks of the streamed map, created by the first update
+	TUniquePtr<FMapChunkStreamer> ChunkStreamer;
+
+	// Search scratch of every routing thread, kept between batches
+	FBatchRouteSearch RouteBatch;
+	TArray<FRouteQuery> RouteQueries;
+	FRouteBatchResult RouteResults;
+
 };
 
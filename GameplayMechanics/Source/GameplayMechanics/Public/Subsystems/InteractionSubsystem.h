@@ -0,0 +1,141 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Components/SceneComponent.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/WeakInterfacePtr.h"
+#include "Interfaces/InteractionInterface.h"
+#include "InteractionSubsystem.generated.h"
+
+/**
+ * Selects the interactable closest to each interactor. The candidates of an interactor are added and removed as they
+ * start and stop overlapping its trigger, and the closest one is selected again every SelectionInterval. Only the
+ * selected interactable is prepared, and it is only cancelled once another one is selected or it stops overlapping.
+ *
+ * Interactables also register in a uniform grid over the world, kept up to date as they move. Indexed interactors
+ * select the closest interactable in front of them from the grid instead, so neither side needs a trigger box.
+ */
+UCLASS()
+class GAMEPLAYMECHANICS_API UInteractionSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	// Origin is the component of the interactor the distances are measured from. Actors without interaction are ignored.
+	void AddCandidate(USceneComponent* Origin, AActor* Candidate);
+
+	void RemoveCandidate(USceneComponent* Origin, AActor* Candidate);
+
+	// Selects from the interactable grid the closest interactable within MaxDistance and MaxAngle degrees of the forward of Origin
+	void AddIndexedInteractor(USceneComponent* Origin, float MaxDistance, float MaxAngle);
+
+	// Cancels the selection of the interactor and forgets it
+	void RemoveInteractor(USceneComponent* Origin);
+
+	AActor* GetSelectedActor(const USceneComponent* Origin) const;
+
+	IInteractionInterface* GetSelectedInteraction(const USceneComponent* Origin) const;
+
+	// Interaction of the actor itself, or else of the first of its components implementing it
+	static IInteractionInterface* FindInteraction(AActor* Actor);
+
+	void RegisterInteractable(AActor* Actor);
+
+	void UnregisterInteractable(AActor* Actor);
+
+	// Closest registered interactable within MaxDistance and MaxAngle degrees of Direction, null when there is none
+	UFUNCTION(BlueprintCallable, Category = "Interaction")
+	AActor* FindBestInteractable(const FVector& Location, const FVector& Direction, float MaxDistance, float MaxAngle) const;
+
+	// Seconds between two selections of the closest candidates, 0 selects every frame
+	UPROPERTY(BlueprintReadWrite, Category = "Interaction")
+	float SelectionInterval;
+
+	// Below it a query visits too many cells of the interactable grid
+	static constexpr float MinInteractableCellSize = 10.f;
+
+	UFUNCTION(BlueprintPure, Category = "Interaction")
+	float GetInteractableCellSize() const
+	{
+		return InteractableCellSize;
+	}
+
+	// Clamped to MinInteractableCellSize, the registered interactables are moved to the cells of the new size
+	UFUNCTION(BlueprintCallable, Category = "Interaction")
+	void SetInteractableCellSize(float CellSize);
+
+private:
+	// Interactable actor with its interaction, looked up once when the actor is added
+	struct FInteractionTarget
+	{
+		TWeakObjectPtr<AActor> Actor;
+		TWeakInterfacePtr<IInteractionInterface> Interaction;
+	};
+
+	struct FInteractor
+	{
+		TWeakObjectPtr<USceneComponent> Origin;
+		TArray<FInteractionTarget> Candidates;
+		FInteractionTarget Selected;
+
+		bool bIndexed = false;
+		float MaxDistance = 0.f;
+		float MaxAngle = 0.f;
+	};
+
+	struct FIndexedInteractable
+	{
+		FInteractionTarget Target;
+		FVector Location;
+		FIntPoint Cell;
+		FDelegateHandle TransformUpdatedHandle;
+	};
+
+	FInteractor* FindInteractor(const USceneComponent* Origin);
+	const FInteractor* FindInteractor(const USceneComponent* Origin) const;
+
+	void SelectClosestCandidate(FInteractor& Interactor);
+
+	// Cancels the previous selection and prepares the new one when they differ
+	void SetSelected(FInteractor& Interactor, const FInteractionTarget& Candidate);
+
+	// The interaction is unset when the actor has none
+	static FInteractionTarget MakeTarget(AActor* Actor);
+
+	// Target of an actor, from the grid when it is registered there. The others are looked up once and kept, with or
+	// without an interaction, so overlapping the same floor or wall again does not scan its components again.
+	FInteractionTarget ResolveTarget(AActor* Actor);
+
+	const FInteractionTarget* FindBestTarget(const FVector& Location, const FVector& Direction, float MaxDistance, float MaxAngle) const;
+
+	FIntPoint GetInteractableCell(const FVector& Location) const;
+
+	void HandleInteractableMoved(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
+	TArray<FInteractor> Interactors;
+
+	TSparseArray<FIndexedInteractable> Interactables;
+	TMap<TObjectKey<AActor>, int32> InteractableIndices;
+
+	// Interactables of each non empty cell of the grid
+	TMap<FIntPoint, TArray<int32>> InteractableCells;
+
+	// Targets of the candidates that are not in the grid, including the actors without interaction
+	TMap<TObjectKey<AActor>, FInteractionTarget> ResolvedTargets;
+	int32 ResolvedTargetsPruneSize = 64;
+
+	// Size of the cells of the interactable grid
+	UPROPERTY(BlueprintReadWrite, BlueprintGetter = GetInteractableCellSize, BlueprintSetter = SetInteractableCellSize, Category = "Interaction", meta = (AllowPrivateAccess = "true"))
+	float InteractableCellSize;
+
+	float TimeSinceSelection;
+};
@@ -0,0 +1,51 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "WallDetectionSubsystem.generated.h"
+
+class AGameplayMechanicsCharacter;
+
+/**
+ * Runs the wall detection traces of every climbing character of the world as one batch of async traces per frame.
+ * A character asks for a trace, the trace is issued from this subsystem's tick with the character's segment at that
+ * time and its result is handed back at the start of the next frame, before the characters tick.
+ */
+UCLASS()
+class GAMEPLAYMECHANICS_API UWallDetectionSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	// Queues a wall trace for Character, at most one per character is queued or running at a time
+	void RequestWallTrace(AGameplayMechanicsCharacter* Character);
+
+	// Traces issued per frame, the remaining requests wait for the next frames in request order. 0 issues every request.
+	UPROPERTY(BlueprintReadWrite, Category = "Jump Detection")
+	int32 MaxTracesPerFrame;
+
+private:
+	void HandleWallTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceData);
+
+	struct FWallTrace
+	{
+		TWeakObjectPtr<AGameplayMechanicsCharacter> Character;
+		FTraceHandle Handle;
+	};
+
+	TArray<TWeakObjectPtr<AGameplayMechanicsCharacter>> PendingCharacters;
+
+	// Traces of the last batch, the user data of a trace is its index. Cleared once their results are delivered.
+	TArray<FWallTrace> RunningTraces;
+
+	FTraceDelegate WallTraceDelegate;
+};
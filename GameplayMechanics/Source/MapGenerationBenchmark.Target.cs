@@ -0,0 +1,24 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+using UnrealBuildTool;
+using System.Collections.Generic;
+
+[SupportedPlatforms(UnrealPlatformClass.Desktop)]
+public class MapGenerationBenchmarkTarget : TargetRules
+{
+	public MapGenerationBenchmarkTarget(TargetInfo Target) : base(Target)
+	{
+		Type = TargetType.Program;
+		LinkType = TargetLinkType.Monolithic;
+		LaunchModuleName = "MapGenerationBenchmark";
+		DefaultBuildSettings = BuildSettingsVersion.V2;
+
+		// Headless console tool, only Core and the map generation pipeline are linked in
+		bBuildDeveloperTools = false;
+		bCompileAgainstEngine = false;
+		bCompileAgainstCoreUObject = false;
+		bCompileAgainstApplicationCore = false;
+		bCompileICU = false;
+		bIsBuildingConsoleApplication = true;
+	}
+}
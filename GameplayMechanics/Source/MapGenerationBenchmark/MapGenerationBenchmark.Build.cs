@@ -0,0 +1,16 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+using System.IO;
+using UnrealBuildTool;
+
+public class MapGenerationBenchmark : ModuleRules
+{
+	public MapGenerationBenchmark(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PublicIncludePaths.Add(Path.Combine(EngineDirectory, "Source/Runtime/Launch/Public"));
+		// For LaunchEngineLoop.cpp include
+		PrivateIncludePaths.Add(Path.Combine(EngineDirectory, "Source/Runtime/Launch/Private"));
+
+		PrivateDependencyModuleNames.AddRange(new string[] { "Core", "Json", "Projects", "MapGenerationCore" });
+	}
+}
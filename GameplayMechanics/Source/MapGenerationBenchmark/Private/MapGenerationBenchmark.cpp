@@ -0,0 +1,771 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CoreMinimal.h"
+#include "RequiredProgramMainCPPInclude.h"
+#include "Algo/Sort.h"
+#include "MapGenerationPipeline.h"
+#include "Cache/MapGenerationCache.h"
+#include "Streaming/MapChunkStreamer.h"
+#include "Routing/BatchRouteSearch.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/JsonWriter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogMapGenerationBenchmark, Log, All);
+
+IMPLEMENT_APPLICATION(MapGenerationBenchmark, "MapGenerationBenchmark");
+
+/**
+ * Usage: MapGenerationBenchmark [-GridExtend=50,100,200] [-SphereRadius=5] [-Seed=123456789] [-Iterations=-1] [-Samples=20] [-Repeat=3] [-CompareReference] [-ScalarSampling] [-SamplingThreads=1,8,32] [-TriangulationThreads=1,2,4,8] [-Edits=100] [-Cache=Dir] [-Routes=1000] [-Chunks=2] [-Json=File]
+ * Every combination of the comma separated lists is generated Repeat times, the best time of each stage is reported.
+ * With several GridExtend values, the growth of each stage against the point count is reported as the exponent k of time ~ points^k.
+ * -ScalarSampling tests the sampling candidates one by one instead of in SIMD batches.
+ * -SamplingThreads also times the tiled parallel sampling with each thread count against the single threaded one.
+ * -TriangulationThreads also times the strip parallel triangulation with each thread count against the single threaded one,
+ * and checks both produce the same triangles.
+ * -Edits also times that many incremental point edits on the generated map against generating it again, and checks the
+ * route matches the one found on paths generated from scratch.
+ * -Cache also saves the generated map to the map cache in Dir and times loading it back, against generating it.
+ * -Routes also times a batch of that many routes between random nodes, on one thread then on every core, and checks both
+ * match routes searched one by one.
+ * -Chunks also streams the chunks up to that many chunks around the origin, with GridExtend as the chunk side, and checks the
+ * triangles of the loaded chunks match one triangulation of the samples of every chunk in memory.
+ * -Json writes the settings, best stage times and counters of every combination to File, to track them across revisions.
+ * -CompareReference also runs the original Bowyer-Watson triangulation on the same points and checks both produce the same triangles.
+ */
+struct FBenchmarkRun
+{
+	FMapGenerationSettings Settings;
+
+	double SamplingTime = 0.0;
+	double TriangulationTime = 0.0;
+	double GraphTime = 0.0;
+	double RouteTime = 0.0;
+
+	int NumPoints = 0;
+	int NumTriangles = 0;
+	int NumEdges = 0;
+	int NumRouteNodes = 0;
+
+	SIZE_T DataBytes = 0;
+	uint64 PeakUsedPhysical = 0;
+
+	// Counters of the run, the same for every repeat since the generation is deterministic
+	FMapGenerationStats Stats;
+
+	double GetTotalTime() const
+	{
+		return SamplingTime + TriangulationTime + GraphTime + RouteTime;
+	}
+};
+
+template<typename ValueType>
+static TArray<ValueType> ParseList(const TCHAR* CmdLine, const TCHAR* Key, ValueType DefaultValue)
+{
+	TArray<ValueType> Result;
+	FString Value;
+
+	if (FParse::Value(CmdLine, Key, Value, false))
+	{
+		TArray<FString> Parts;
+		Value.ParseIntoArray(Parts, TEXT(","));
+
+		for (const FString& Part : Parts)
+		{
+			ValueType PartValue;
+			LexFromString(PartValue, *Part);
+			Result.Add(PartValue);
+		}
+	}
+
+	if (Result.Num() == 0)
+	{
+		Result.Add(DefaultValue);
+	}
+
+	return Result;
+}
+
+// Triangle with its point indices sorted, so the same triangle compares equal whatever the vertex order is
+struct FTriangleKey
+{
+	int32 Vertices[3];
+
+	explicit FTriangleKey(const FGeneratedTriangle& Triangle)
+	{
+		Vertices[0] = Triangle.Vertex1;
+		Vertices[1] = Triangle.Vertex2;
+		Vertices[2] = Triangle.Vertex3;
+
+		Algo::Sort(Vertices);
+	}
+
+	bool operator<(const FTriangleKey& Other) const
+	{
+		for (int32 Index = 0; Index < 3; ++Index)
+		{
+			if (Vertices[Index] != Other.Vertices[Index])
+			{
+				return Vertices[Index] < Other.Vertices[Index];
+			}
+		}
+
+		return false;
+	}
+};
+
+static TArray<FTriangleKey> GetSortedTriangleKeys(const TArray<FGeneratedTriangle>& Triangles)
+{
+	TArray<FTriangleKey> Keys;
+	Keys.Reserve(Triangles.Num());
+
+	for (const FGeneratedTriangle& Triangle : Triangles)
+	{
+		Keys.Emplace(Triangle);
+	}
+
+	Keys.Sort();
+	return Keys;
+}
+
+// Number of triangles present in only one of the two sorted lists
+static int32 CountMismatchedTriangles(const TArray<FTriangleKey>& A, const TArray<FTriangleKey>& B)
+{
+	int32 Mismatches = 0;
+	int32 IndexA = 0;
+	int32 IndexB = 0;
+
+	while (IndexA < A.Num() && IndexB < B.Num())
+	{
+		if (A[IndexA] < B[IndexB])
+		{
+			++Mismatches;
+			++IndexA;
+		}
+		else if (B[IndexB] < A[IndexA])
+		{
+			++Mismatches;
+			++IndexB;
+		}
+		else
+		{
+			++IndexA;
+			++IndexB;
+		}
+	}
+
+	return Mismatches + (A.Num() - IndexA) + (B.Num() - IndexB);
+}
+
+static void CompareWithReference(const FMapGenerationSettings& Settings)
+{
+	FMapGenerationPipeline Pipeline(Settings);
+	Pipeline.PoisonDiskSampling();
+
+	double StartTime = FPlatformTime::Seconds();
+	Pipeline.DelaunaryTriangulation();
+	const double TriangulationTime = FPlatformTime::Seconds() - StartTime;
+	const TArray<FTriangleKey> Triangles = GetSortedTriangleKeys(Pipeline.Triangles);
+
+	StartTime = FPlatformTime::Seconds();
+	Pipeline.DelaunaryTriangulationBowyerWatson();
+	const double ReferenceTime = FPlatformTime::Seconds() - StartTime;
+	const TArray<FTriangleKey> ReferenceTriangles = GetSortedTriangleKeys(Pipeline.Triangles);
+
+	const int32 Mismatches = CountMismatchedTriangles(Triangles, ReferenceTriangles);
+
+	UE_LOG(LogMapGenerationBenchmark, Display, TEXT("%10s Delaunay %10.3f ms, Bowyer-Watson reference %10.3f ms (x%.1f), %d/%d triangles differ"),
+		TEXT(""), TriangulationTime * 1000.0, ReferenceTime * 1000.0, ReferenceTime / FMath::Max(TriangulationTime, 1e-9),
+		Mismatches, ReferenceTriangles.Num());
+}
+
+static void CompareParallelSampling(const FMapGenerationSettings& Settings, const TArray<int32>& SamplingThreads, int32 Repeat)
+{
+	auto TimeSampling = [Repeat](const FMapGenerationSettings& SamplingSettings, int32& OutNumPoints)
+	{
+		FMapGenerationPipeline Pipeline(SamplingSettings);
+		double BestTime = TNumericLimits<double>::Max();
+
+		for (int32 RunIndex = 0; RunIndex < Repeat; ++RunIndex)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			Pipeline.PoisonDiskSampling();
+			BestTime = FMath::Min(BestTime, FPlatformTime::Seconds() - StartTime);
+		}
+
+		OutNumPoints = Pipeline.GeneratedPoints.Num();
+		return BestTime;
+	};
+
+	FMapGenerationSettings SerialSettings = Settings;
+	SerialSettings.bParallelSampling = false;
+
+	int32 SerialPoints = 0;
+	const double SerialTime = TimeSampling(SerialSettings, SerialPoints);
+
+	for (const int32 NumThreads : SamplingThreads)
+	{
+		FMapGenerationSettings ParallelSettings = Settings;
+		ParallelSettings.bParallelSampling = true;
+		ParallelSettings.NumSamplingThreads = NumThreads;
+
+		int32 ParallelPoints = 0;
+		const double ParallelTime = TimeSampling(ParallelSettings, ParallelPoints);
+
+		UE_LOG(LogMapGenerationBenchmark, Display, TEXT("%10s Sampling on %3d threads %10.3f ms, %8d points, single threaded %10.3f ms, %8d points (x%.2f)"),
+			TEXT(""), NumThreads, ParallelTime * 1000.0, ParallelPoints, SerialTime * 1000.0, SerialPoints, SerialTime / FMath::Max(ParallelTime, 1e-9));
+	}
+}
+
+static void CompareParallelTriangulation(const FMapGenerationSettings& Settings, const TArray<int32>& TriangulationThreads, int32 Repeat)
+{
+	FMapGenerationPipeline Pipeline(Settings);
+	Pipeline.PoisonDiskSampling();
+
+	auto TimeTriangulation = [&Pipeline, Repeat]()
+	{
+		double BestTime = TNumericLimits<double>::Max();
+
+		for (int32 RunIndex = 0; RunIndex < Repeat; ++RunIndex)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			Pipeline.DelaunaryTriangulation();
+			BestTime = FMath::Min(BestTime, FPlatformTime::Seconds() - StartTime);
+		}
+
+		return BestTime;
+	};
+
+	Pipeline.Settings.bParallelTriangulation = false;
+	const double SerialTime = TimeTriangulation();
+	const TArray<FTriangleKey> SerialTriangles = GetSortedTriangleKeys(Pipeline.Triangles);
+
+	for (const int32 NumThreads : TriangulationThreads)
+	{
+		Pipeline.Settings.bParallelTriangulation = true;
+		Pipeline.Settings.NumTriangulationThreads = NumThreads;
+
+		const double ParallelTime = TimeTriangulation();
+		const int32 Mismatches = CountMismatchedTriangles(GetSortedTriangleKeys(Pipeline.Triangles), SerialTriangles);
+
+		UE_LOG(LogMapGenerationBenchmark, Display, TEXT("%10s Delaunay on %3d threads %10.3f ms, single threaded %10.3f ms (x%.2f), %d/%d triangles differ"),
+			TEXT(""), NumThreads, ParallelTime * 1000.0, SerialTime * 1000.0, SerialTime / FMath::Max(ParallelTime, 1e-9), Mismatches, SerialTriangles.Num());
+	}
+}
+
+static void CompareIncrementalEdits(const FMapGenerationSettings& Settings, int32 NumEdits)
+{
+	FMapGenerationPipeline Pipeline(Settings);
+
+	const double GenerateStartTime = FPlatformTime::Seconds();
+	Pipeline.Generate();
+	const double GenerateTime = FPlatformTime::Seconds() - GenerateStartTime;
+
+	FRandomStream Stream(Settings.Seed);
+	const float GridExtend = Settings.GridExtend;
+
+	int32 NumRouteChanges = 0;
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Cycle through the kinds of edits a designer makes: dragging the start and end along the border, moving, adding and removing points
+	for (int32 EditIndex = 0; EditIndex < NumEdits; ++EditIndex)
+	{
+		const TArray<int32> PreviousRoute = Pipeline.Routes;
+		const FVector2D Position(Stream.FRandRange(0.0f, GridExtend), Stream.FRandRange(0.0f, GridExtend));
+
+		switch (EditIndex % 5)
+		{
+		case 0:
+			Pipeline.SetStartPoint(FVector2D(Pipeline.StartPoint.X, Position.Y));
+			break;
+		case 1:
+			Pipeline.SetEndPoint(FVector2D(Pipeline.EndPoint.X, Position.Y));
+			break;
+		case 2:
+			Pipeline.MovePoint(Stream.RandHelper(Pipeline.GeneratedPoints.Num()), Position);
+			break;
+		case 3:
+			Pipeline.AddPoint(Position);
+			break;
+		default:
+			Pipeline.RemovePoint(Stream.RandHelper(Pipeline.GeneratedPoints.Num()));
+			break;
+		}
+
+		NumRouteChanges += Pipeline.Routes != PreviousRoute ? 1 : 0;
+	}
+
+	const double EditTime = (FPlatformTime::Seconds() - StartTime) / FMath::Max(1, NumEdits);
+
+	FMapGenerationPipeline Rebuilt = Pipeline;
+	Rebuilt.GeneratePaths();
+	Rebuilt.FindRoutes();
+
+	UE_LOG(LogMapGenerationBenchmark, Display, TEXT("%10s %d edits %10.3f ms each, generate %10.3f ms (x%.0f), %d changed the route, route %s a full rebuild of the paths"),
+		TEXT(""), NumEdits, EditTime * 1000.0, GenerateTime * 1000.0, GenerateTime / FMath::Max(EditTime, 1e-9), NumRouteChanges,
+		Rebuilt.Routes == Pipeline.Routes ? TEXT("matches") : TEXT("DIFFERS from"));
+}
+
+static void CompareCachedLoad(const FMapGenerationSettings& Settings, const FString& CacheDirectory, int32 Repeat)
+{
+	FMapGenerationPipeline Pipeline(Settings);
+
+	const double GenerateStartTime = FPlatformTime::Seconds();
+	Pipeline.Generate();
+	const double GenerateTime = FPlatformTime::Seconds() - GenerateStartTime;
+
+	const FMapGenerationCache Cache(CacheDirectory);
+
+	const double SaveStartTime = FPlatformTime::Seconds();
+	const bool bSaved = Cache.Save(Settings, Pipeline.GetView());
+	const double SaveTime = FPlatformTime::Seconds() - SaveStartTime;
+
+	if (!bSaved)
+	{
+		UE_LOG(LogMapGenerationBenchmark, Warning, TEXT("%10s could not save %s"), TEXT(""), *Cache.GetFilename(Settings));
+		return;
+	}
+
+	double LoadTime = TNumericLimits<double>::Max();
+	bool bMatches = true;
+
+	for (int32 RunIndex = 0; RunIndex < Repeat && bMatches; ++RunIndex)
+	{
+		const double LoadStartTime = FPlatformTime::Seconds();
+		const TUniquePtr<FMapGenerationCacheFile> File = Cache.Load(Settings);
+		LoadTime = FMath::Min(LoadTime, FPlatformTime::Seconds() - LoadStartTime);
+
+		if (!File.IsValid())
+		{
+			bMatches = false;
+			break;
+		}
+
+		const FMapGenerationView& View = File->GetView();
+		bMatches = View.GeneratedPoints.Num() == Pipeline.GeneratedPoints.Num() && View.Triangles.Num() == Pipeline.Triangles.Num() && View.Edges.Num() == Pipeline.Edges.Num()
+			&& FMemory::Memcmp(View.GeneratedPoints.GetData(), Pipeline.GeneratedPoints.GetData(), Pipeline.GeneratedPoints.Num() * sizeof(FVector2D)) == 0
+			&& View.Routes.Num() == Pipeline.Routes.Num() && FMemory::Memcmp(View.Routes.GetData(), Pipeline.Routes.GetData(), Pipeline.Routes.Num() * sizeof(int32)) == 0;
+	}
+
+	UE_LOG(LogMapGenerationBenchmark, Display, TEXT("%10s cache load %10.3f ms, save %10.3f ms, generate %10.3f ms (x%.0f), %.2f MiB file, cached map %s the generated one"),
+		TEXT(""), LoadTime * 1000.0, SaveTime * 1000.0, GenerateTime * 1000.0, GenerateTime / FMath::Max(LoadTime, 1e-9),
+		IFileManager::Get().FileSize(*Cache.GetFilename(Settings)) / (1024.0 * 1024.0), bMatches ? TEXT("matches") : TEXT("DIFFERS from"));
+}
+
+static void CompareBatchRoutes(const FMapGenerationSettings& Settings, int32 NumRoutes, int32 Repeat)
+{
+	FMapGenerationPipeline Pipeline(Settings);
+	Pipeline.Generate();
+
+	FRandomStream Stream(Settings.Seed);
+	TArray<FRouteQuery> Queries;
+	Queries.Reserve(NumRoutes);
+
+	for (int32 Index = 0; Index < NumRoutes; ++Index)
+	{
+		Queries.Add(FRouteQuery(Stream.RandHelper(Pipeline.Paths.Num()), Stream.RandHelper(Pipeline.Paths.Num())));
+	}
+
+	FBatchRouteSearch BatchSearch;
+
+	auto TimeBatch = [&](int32 NumThreads, FRouteBatchResult& OutRoutes)
+	{
+		double BestTime = TNumericLimits<double>::Max();
+
+		for (int32 RunIndex = 0; RunIndex < Repeat; ++RunIndex)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			BatchSearch.FindRoutes(Pipeline.Paths, Pipeline.PathChildNodes, Queries, NumThreads, OutRoutes);
+			BestTime = FMath::Min(BestTime, FPlatformTime::Seconds() - StartTime);
+		}
+
+		return BestTime;
+	};
+
+	FRouteBatchResult SerialRoutes;
+	const double SerialTime = TimeBatch(1, SerialRoutes);
+
+	FRouteBatchResult ParallelRoutes;
+	const double ParallelTime = TimeBatch(0, ParallelRoutes);
+
+	FRouteSearch Search;
+	TArray<int32> Route;
+	int32 NumFound = 0;
+	int32 Mismatches = 0;
+
+	for (int32 Query = 0; Query < Queries.Num(); ++Query)
+	{
+		Search.FindRoute(Pipeline.Paths, Pipeline.PathChildNodes, Queries[Query].Start, Queries[Query].Goal, Route);
+
+		NumFound += Route.Num() > 0 ? 1 : 0;
+		auto MatchesRoute = [&Route](TConstArrayView<int32> BatchRoute)
+		{
+			return BatchRoute.Num() == Route.Num() && FMemory::Memcmp(BatchRoute.GetData(), Route.GetData(), Route.Num() * sizeof(int32)) == 0;
+		};
+
+		Mismatches += MatchesRoute(SerialRoutes.GetRoute(Query)) && MatchesRoute(ParallelRoutes.GetRoute(Query)) ? 0 : 1;
+	}
+
+	UE_LOG(LogMapGenerationBenchmark, Display, TEXT("%10s %d routes on every core %10.3f ms, single threaded %10.3f ms (x%.2f), %d reachable, %d differ from single searches"),
+		TEXT(""), NumRoutes, ParallelTime * 1000.0, SerialTime * 1000.0, SerialTime / FMath::Max(ParallelTime, 1e-9), NumFound, Mismatches);
+}
+
+static void CompareStreamedChunks(const FMapGenerationSettings& Settings, int32 LoadRadius)
+{
+	FMapChunkStreamer Streamer(Settings, LoadRadius, TNumericLimits<SIZE_T>::Max());
+
+	const double StartTime = FPlatformTime::Seconds();
+	Streamer.Update(FVector2D::ZeroVector);
+	const double StreamTime = FPlatformTime::Seconds() - StartTime;
+
+	// Every chunk a loaded chunk can have been triangulated with, the samples of the chunks further away are never in memory
+	const int32 MaxRadius = LoadRadius + FMapChunkStreamer::MaxTriangulationRings;
+
+	TArray<FVector2D> Points;
+	TMap<FVector2D, int32> PointIndices;
+	TArray<bool> LoadedPoints;
+
+	for (int32 X = -MaxRadius; X <= MaxRadius; ++X)
+	{
+		for (int32 Y = -MaxRadius; Y <= MaxRadius; ++Y)
+		{
+			const FMapChunk* Chunk = Streamer.FindChunk(FIntPoint(X, Y));
+
+			for (int32 Point = 0; Chunk != nullptr && Point < Chunk->NumOwnPoints; ++Point)
+			{
+				PointIndices.Add(Chunk->Points[Point], Points.Add(Chunk->Points[Point]));
+				LoadedPoints.Add(FMath::Abs(X) <= LoadRadius && FMath::Abs(Y) <= LoadRadius);
+			}
+		}
+	}
+
+	TArray<FGeneratedTriangle> ChunkTriangles;
+	bool bKnownPoints = true;
+
+	for (const FIntPoint& Coord : Streamer.GetLoadedChunks())
+	{
+		const FMapChunk* Chunk = Streamer.FindChunk(Coord);
+
+		for (const FGeneratedTriangle& Triangle : Chunk->Triangles)
+		{
+			const int32* Corners[3] = { PointIndices.Find(Chunk->Points[Triangle.Vertex1]), PointIndices.Find(Chunk->Points[Triangle.Vertex2]), PointIndices.Find(Chunk->Points[Triangle.Vertex3]) };
+
+			if (Corners[0] == nullptr || Corners[1] == nullptr || Corners[2] == nullptr)
+			{
+				bKnownPoints = false;
+				continue;
+			}
+
+			ChunkTriangles.Add(FGeneratedTriangle(*Corners[0], *Corners[1], *Corners[2]));
+		}
+	}
+
+	FDelaunayTriangulation Triangulation;
+	TArray<FGeneratedTriangle> Triangles;
+	TArray<int32> HalfEdgeTwins;
+
+	const double TriangulationStartTime = FPlatformTime::Seconds();
+	Triangulation.Triangulate(Points);
+	Triangulation.GetTriangles(Triangles, HalfEdgeTwins);
+	const double TriangulationTime = FPlatformTime::Seconds() - TriangulationStartTime;
+
+	// Triangles owned by the loaded chunks, the ones whose lowest point (by X then Y) is one of their samples
+	TArray<FGeneratedTriangle> LoadedTriangles;
+
+	for (const FGeneratedTriangle& Triangle : Triangles)
+	{
+		int32 Lowest = Triangle.Vertex1;
+
+		for (int32 Corner = 1; Corner < 3; ++Corner)
+		{
+			if (Points[Triangle[Corner]].X < Points[Lowest].X || (Points[Triangle[Corner]].X == Points[Lowest].X && Points[Triangle[Corner]].Y < Points[Lowest].Y))
+			{
+				Lowest = Triangle[Corner];
+			}
+		}
+
+		if (LoadedPoints[Lowest])
+		{
+			LoadedTriangles.Add(Triangle);
+		}
+	}
+
+	const TArray<FTriangleKey> Expected = GetSortedTriangleKeys(LoadedTriangles);
+	const int32 Mismatches = CountMismatchedTriangles(GetSortedTriangleKeys(ChunkTriangles), Expected);
+
+	UE_LOG(LogMapGenerationBenchmark, Display, TEXT("%10s %d chunks streamed %10.3f ms, %d in memory, one triangulation of their %d samples %10.3f ms, %d/%d triangles differ%s"),
+		TEXT(""), Streamer.GetLoadedChunks().Num(), StreamTime * 1000.0, Streamer.GetNumChunks(), Points.Num(), TriangulationTime * 1000.0,
+		Mismatches, Expected.Num(), bKnownPoints ? TEXT("") : TEXT(", some chunk triangles use UNKNOWN samples"));
+}
+
+static FBenchmarkRun RunPipeline(const FMapGenerationSettings& Settings)
+{
+	FBenchmarkRun Run;
+	FMapGenerationPipeline Pipeline(Settings);
+
+	Pipeline.Generate();
+
+	Run.Settings = Settings;
+	Run.Stats = Pipeline.Stats;
+	Run.SamplingTime = Pipeline.Stats.Sampling.Time;
+	Run.TriangulationTime = Pipeline.Stats.Triangulation.Time;
+	Run.GraphTime = Pipeline.Stats.Paths.Time;
+	Run.RouteTime = Pipeline.Stats.Route.Time;
+
+	Run.NumPoints = Pipeline.GeneratedPoints.Num();
+	Run.NumTriangles = Pipeline.Triangles.Num();
+	Run.NumEdges = Pipeline.Edges.Num();
+	Run.NumRouteNodes = Pipeline.Routes.Num();
+	Run.DataBytes = Pipeline.GetAllocatedSize();
+	Run.PeakUsedPhysical = FPlatformMemory::GetStats().PeakUsedPhysical;
+
+	return Run;
+}
+
+// Exponent k such that Time ~ Points^k between two runs, 1 means linear scaling
+static double GetScalingExponent(int SmallPoints, double SmallTime, int LargePoints, double LargeTime)
+{
+	if (SmallPoints <= 0 || LargePoints <= SmallPoints || SmallTime <= 0.0 || LargeTime <= 0.0)
+	{
+		return 0.0;
+	}
+
+	return FMath::Loge(LargeTime / SmallTime) / FMath::Loge(double(LargePoints) / double(SmallPoints));
+}
+
+static void LogScaling(float SphereRadius, int32 Seed, const FBenchmarkRun& Small, const FBenchmarkRun& Large)
+{
+	UE_LOG(LogMapGenerationBenchmark, Display, TEXT("%10s %8.2f %12d %8d -> %8d points | scaling k: Sample %.2f, Delaunay %.2f, Graph %.2f, Route %.2f, Total %.2f"),
+		TEXT(""), SphereRadius, Seed, Small.NumPoints, Large.NumPoints,
+		GetScalingExponent(Small.NumPoints, Small.SamplingTime, Large.NumPoints, Large.SamplingTime),
+		GetScalingExponent(Small.NumPoints, Small.TriangulationTime, Large.NumPoints, Large.TriangulationTime),
+		GetScalingExponent(Small.NumPoints, Small.GraphTime, Large.NumPoints, Large.GraphTime),
+		GetScalingExponent(Small.NumPoints, Small.RouteTime, Large.NumPoints, Large.RouteTime),
+		GetScalingExponent(Small.NumPoints, Small.GetTotalTime(), Large.NumPoints, Large.GetTotalTime()));
+}
+
+static bool WriteJsonSummary(const FString& Filename, const TArray<FBenchmarkRun>& Runs)
+{
+	FString Json;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+
+	Writer->WriteObjectStart();
+	Writer->WriteArrayStart(TEXT("Runs"));
+
+	for (const FBenchmarkRun& Run : Runs)
+	{
+		const FMapGenerationStats& Stats = Run.Stats;
+
+		Writer->WriteObjectStart();
+
+		Writer->WriteObjectStart(TEXT("Settings"));
+		Writer->WriteValue(TEXT("Seed"), Run.Settings.Seed);
+		Writer->WriteValue(TEXT("GridExtend"), Run.Settings.GridExtend);
+		Writer->WriteValue(TEXT("SphereRadius"), Run.Settings.SphereRadius);
+		Writer->WriteValue(TEXT("Iterations"), Run.Settings.Iterations);
+		Writer->WriteValue(TEXT("NumSampleBeforeRejection"), Run.Settings.NumSampleBeforeRejection);
+		Writer->WriteValue(TEXT("BatchCandidateTests"), Run.Settings.bBatchCandidateTests);
+		Writer->WriteObjectEnd();
+
+		Writer->WriteValue(TEXT("NumPoints"), Run.NumPoints);
+		Writer->WriteValue(TEXT("NumTriangles"), Run.NumTriangles);
+		Writer->WriteValue(TEXT("NumEdges"), Run.NumEdges);
+		Writer->WriteValue(TEXT("DataBytes"), int64(Run.DataBytes));
+		Writer->WriteValue(TEXT("PeakUsedPhysical"), int64(Run.PeakUsedPhysical));
+		Writer->WriteValue(TEXT("TotalMs"), Run.GetTotalTime() * 1000.0);
+
+		Writer->WriteObjectStart(TEXT("Sampling"));
+		Writer->WriteValue(TEXT("Ms"), Run.SamplingTime * 1000.0);
+		Writer->WriteValue(TEXT("TestedCandidates"), Stats.Sampling.NumTestedCandidates);
+		Writer->WriteValue(TEXT("AcceptedCandidates"), Stats.Sampling.NumAcceptedCandidates);
+		Writer->WriteValue(TEXT("RejectedCandidates"), Stats.Sampling.NumRejectedCandidates);
+		Writer->WriteValue(TEXT("RetiredSpawnPoints"), Stats.Sampling.NumRetiredSpawnPoints);
+		Writer->WriteObjectEnd();
+
+		Writer->WriteObjectStart(TEXT("Triangulation"));
+		Writer->WriteValue(TEXT("Ms"), Run.TriangulationTime * 1000.0);
+		Writer->WriteValue(TEXT("InsertedPoints"), Stats.Triangulation.NumInsertedPoints);
+		Writer->WriteValue(TEXT("CreatedTriangles"), Stats.Triangulation.NumCreatedTriangles);
+		Writer->WriteValue(TEXT("RemovedTriangles"), Stats.Triangulation.NumRemovedTriangles);
+		Writer->WriteValue(TEXT("MeanCavityTriangles"), Stats.Triangulation.GetMeanCavityTriangles());
+		Writer->WriteValue(TEXT("MaxCavityTriangles"), Stats.Triangulation.MaxCavityTriangles);
+		Writer->WriteObjectEnd();
+
+		Writer->WriteObjectStart(TEXT("Paths"));
+		Writer->WriteValue(TEXT("Ms"), Run.GraphTime * 1000.0);
+		Writer->WriteValue(TEXT("Nodes"), Stats.Paths.NumNodes);
+		Writer->WriteValue(TEXT("ChildLinks"), Stats.Paths.NumChildLinks);
+		Writer->WriteObjectEnd();
+
+		Writer->WriteObjectStart(TEXT("Route"));
+		Writer->WriteValue(TEXT("Ms"), Run.RouteTime * 1000.0);
+		Writer->WriteValue(TEXT("ExpandedNodes"), Stats.Route.NumExpandedNodes);
+		Writer->WriteValue(TEXT("MaxOpenNodes"), Stats.Route.MaxOpenNodes);
+		Writer->WriteValue(TEXT("RouteNodes"), Stats.Route.NumRouteNodes);
+		Writer->WriteObjectEnd();
+
+		Writer->WriteObjectEnd();
+	}
+
+	Writer->WriteArrayEnd();
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	return FFileHelper::SaveStringToFile(Json, *Filename);
+}
+
+static void KeepBestRun(FBenchmarkRun& Best, const FBenchmarkRun& Run)
+{
+	Best.SamplingTime = FMath::Min(Best.SamplingTime, Run.SamplingTime);
+	Best.TriangulationTime = FMath::Min(Best.TriangulationTime, Run.TriangulationTime);
+	Best.GraphTime = FMath::Min(Best.GraphTime, Run.GraphTime);
+	Best.RouteTime = FMath::Min(Best.RouteTime, Run.RouteTime);
+	Best.PeakUsedPhysical = FMath::Max(Best.PeakUsedPhysical, Run.PeakUsedPhysical);
+}
+
+INT32_MAIN_INT32_ARGC_TCHAR_ARGV()
+{
+	FTaskTagScope Scope(ETaskTag::EGameThread);
+	ON_SCOPE_EXIT
+	{
+		LLM(FLowLevelMemTracker::Get().UpdateStatsPerFrame());
+		RequestEngineExit(TEXT("Exiting"));
+		FEngineLoop::AppPreExit();
+		FModuleManager::Get().UnloadModulesAtShutdown();
+		FEngineLoop::AppExit();
+	};
+
+	if (int32 Ret = GEngineLoop.PreInit(ArgC, ArgV))
+	{
+		return Ret;
+	}
+
+	const TCHAR* CmdLine = FCommandLine::Get();
+	const FMapGenerationSettings Defaults;
+
+	const TArray<float> GridExtends = ParseList<float>(CmdLine, TEXT("GridExtend="), Defaults.GridExtend);
+	const TArray<float> SphereRadii = ParseList<float>(CmdLine, TEXT("SphereRadius="), Defaults.SphereRadius);
+	const TArray<int32> Seeds = ParseList<int32>(CmdLine, TEXT("Seed="), Defaults.Seed);
+
+	FString SamplingThreadsValue;
+	const TArray<int32> SamplingThreads = FParse::Value(CmdLine, TEXT("SamplingThreads="), SamplingThreadsValue, false) ? ParseList<int32>(CmdLine, TEXT("SamplingThreads="), 0) : TArray<int32>();
+
+	FString TriangulationThreadsValue;
+	const TArray<int32> TriangulationThreads = FParse::Value(CmdLine, TEXT("TriangulationThreads="), TriangulationThreadsValue, false) ? ParseList<int32>(CmdLine, TEXT("TriangulationThreads="), 0) : TArray<int32>();
+
+	int32 Iterations = -1;
+	int32 NumSamples = 20;
+	int32 Repeat = 3;
+	int32 NumEdits = 0;
+	int32 NumRoutes = 0;
+	int32 ChunkLoadRadius = -1;
+	FString CacheDirectory;
+	FString JsonFilename;
+	const bool bCompareReference = FParse::Param(CmdLine, TEXT("CompareReference"));
+	const bool bScalarSampling = FParse::Param(CmdLine, TEXT("ScalarSampling"));
+	FParse::Value(CmdLine, TEXT("Iterations="), Iterations);
+	FParse::Value(CmdLine, TEXT("Samples="), NumSamples);
+	FParse::Value(CmdLine, TEXT("Repeat="), Repeat);
+	FParse::Value(CmdLine, TEXT("Edits="), NumEdits);
+	FParse::Value(CmdLine, TEXT("Routes="), NumRoutes);
+	FParse::Value(CmdLine, TEXT("Chunks="), ChunkLoadRadius);
+	FParse::Value(CmdLine, TEXT("Cache="), CacheDirectory);
+	FParse::Value(CmdLine, TEXT("Json="), JsonFilename);
+	Repeat = FMath::Max(1, Repeat);
+
+	UE_LOG(LogMapGenerationBenchmark, Display, TEXT("%10s %8s %12s %8s %9s %9s | %10s %10s %10s %10s %10s | %10s %10s"),
+		TEXT("GridExtend"), TEXT("Radius"), TEXT("Seed"), TEXT("Points"), TEXT("Triangles"), TEXT("Edges"),
+		TEXT("Sample ms"), TEXT("Delaunay ms"), TEXT("Graph ms"), TEXT("Route ms"), TEXT("Total ms"), TEXT("Data MiB"), TEXT("Peak MiB"));
+
+	// Best run of every combination, indexed [GridExtend][SphereRadius][Seed]
+	TArray<FBenchmarkRun> BestRuns;
+	BestRuns.Reserve(GridExtends.Num() * SphereRadii.Num() * Seeds.Num());
+
+	for (const float GridExtend : GridExtends)
+	{
+		for (const float SphereRadius : SphereRadii)
+		{
+			for (const int32 Seed : Seeds)
+			{
+				FMapGenerationSettings Settings;
+				Settings.Seed = Seed;
+				Settings.GridExtend = GridExtend;
+				Settings.SphereRadius = SphereRadius;
+				Settings.Iterations = Iterations;
+				Settings.NumSampleBeforeRejection = NumSamples;
+				Settings.bBatchCandidateTests = !bScalarSampling;
+
+				FBenchmarkRun Best = RunPipeline(Settings);
+
+				for (int32 RunIndex = 1; RunIndex < Repeat; ++RunIndex)
+				{
+					KeepBestRun(Best, RunPipeline(Settings));
+				}
+
+				UE_LOG(LogMapGenerationBenchmark, Display, TEXT("%10.1f %8.2f %12d %8d %9d %9d | %10.3f %10.3f %10.3f %10.3f %10.3f | %10.2f %10.2f"),
+					GridExtend, SphereRadius, Seed, Best.NumPoints, Best.NumTriangles, Best.NumEdges,
+					Best.SamplingTime * 1000.0, Best.TriangulationTime * 1000.0, Best.GraphTime * 1000.0, Best.RouteTime * 1000.0, Best.GetTotalTime() * 1000.0,
+					Best.DataBytes / (1024.0 * 1024.0), Best.PeakUsedPhysical / (1024.0 * 1024.0));
+
+				if (bCompareReference)
+				{
+					CompareWithReference(Settings);
+				}
+
+				if (SamplingThreads.Num() > 0)
+				{
+					CompareParallelSampling(Settings, SamplingThreads, Repeat);
+				}
+
+				if (TriangulationThreads.Num() > 0)
+				{
+					CompareParallelTriangulation(Settings, TriangulationThreads, Repeat);
+				}
+
+				if (NumEdits > 0)
+				{
+					CompareIncrementalEdits(Settings, NumEdits);
+				}
+
+				if (NumRoutes > 0)
+				{
+					CompareBatchRoutes(Settings, NumRoutes, Repeat);
+				}
+
+				if (!CacheDirectory.IsEmpty())
+				{
+					CompareCachedLoad(Settings, CacheDirectory, Repeat);
+				}
+
+				if (ChunkLoadRadius >= 0)
+				{
+					CompareStreamedChunks(Settings, ChunkLoadRadius);
+				}
+
+				BestRuns.Add(Best);
+			}
+		}
+	}
+
+	// Consecutive grid sizes with the same radius and seed
+	const int32 RunsPerGridExtend = SphereRadii.Num() * Seeds.Num();
+
+	for (int32 GridIndex = 1; GridIndex < GridExtends.Num(); ++GridIndex)
+	{
+		for (int32 RadiusIndex = 0; RadiusIndex < SphereRadii.Num(); ++RadiusIndex)
+		{
+			for (int32 SeedIndex = 0; SeedIndex < Seeds.Num(); ++SeedIndex)
+			{
+				const int32 RunIndex = GridIndex * RunsPerGridExtend + RadiusIndex * Seeds.Num() + SeedIndex;
+				LogScaling(SphereRadii[RadiusIndex], Seeds[SeedIndex], BestRuns[RunIndex - RunsPerGridExtend], BestRuns[RunIndex]);
+			}
+		}
+	}
+
+	if (!JsonFilename.IsEmpty() && !WriteJsonSummary(JsonFilename, BestRuns))
+	{
+		UE_LOG(LogMapGenerationBenchmark, Warning, TEXT("Could not write %s"), *JsonFilename);
+	}
+
+	return 0;
+}
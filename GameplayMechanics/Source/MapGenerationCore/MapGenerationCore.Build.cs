@@ -0,0 +1,14 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+using UnrealBuildTool;
+
+public class MapGenerationCore : ModuleRules
+{
+	public MapGenerationCore(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		// Only Core on purpose: the generation pipeline has to build for the game, the editor and the headless benchmark program.
+		PublicDependencyModuleNames.AddRange(new string[] { "Core" });
+	}
+}
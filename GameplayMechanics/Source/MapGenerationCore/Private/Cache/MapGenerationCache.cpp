@@ -0,0 +1,299 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Cache/MapGenerationCache.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+// The arrays are stored with their in-memory layout
+static_assert(PLATFORM_LITTLE_ENDIAN, "Cached maps are stored little endian");
+static_assert(sizeof(FVector2D) == 16 && sizeof(FGeneratedTriangle) == 12 && sizeof(FGeneratedEdge) == 8 && sizeof(FGeneratedNode) == 32,
+	"A cached type changed, bump FMapGenerationCache::FormatVersion");
+
+// "MAPC" read as a little endian integer
+static constexpr uint32 MapCacheMagic = 0x4350414D;
+
+// Every array starts on this boundary so it can be read in place, the mapping itself starts on a page
+static constexpr uint64 MapCacheAlignment = 16;
+
+enum class EMapCacheSection : uint32
+{
+	GeneratedPoints,
+	Triangles,
+	HalfEdgeTwins,
+	Edges,
+	Paths,
+	PathChildNodes,
+	Routes,
+	Num
+};
+
+struct FMapCacheSection
+{
+	uint64 Offset;
+	uint64 Num;
+};
+
+struct FMapCacheHeader
+{
+	uint32 Magic;
+	uint32 Version;
+	uint8 SettingsHash[20];
+	int32 StartPointIndex;
+	int32 EndPointIndex;
+	uint32 Padding;
+	FVector2D StartPoint;
+	FVector2D EndPoint;
+	FMapCacheSection Sections[uint32(EMapCacheSection::Num)];
+};
+
+static_assert(sizeof(FMapCacheHeader) == 184, "The header layout changed, bump FMapGenerationCache::FormatVersion");
+
+template <typename ElementType>
+static void WriteSection(TArray<uint8>& Buffer, FMapCacheHeader& Header, EMapCacheSection Section, TConstArrayView<ElementType> Elements)
+{
+	Buffer.SetNumZeroed(Align(Buffer.Num(), MapCacheAlignment));
+
+	Header.Sections[uint32(Section)].Offset = Buffer.Num();
+	Header.Sections[uint32(Section)].Num = Elements.Num();
+
+	Buffer.Append(reinterpret_cast<const uint8*>(Elements.GetData()), Elements.Num() * sizeof(ElementType));
+}
+
+template <typename ElementType>
+static bool ReadSection(const uint8* Data, uint64 Size, const FMapCacheHeader& Header, EMapCacheSection Section, TConstArrayView<ElementType>& OutElements)
+{
+	const FMapCacheSection& Range = Header.Sections[uint32(Section)];
+
+	if (Range.Offset % MapCacheAlignment != 0 || Range.Offset > Size || Range.Num > (Size - Range.Offset) / sizeof(ElementType) || Range.Num > uint64(MAX_int32))
+	{
+		return false;
+	}
+
+	OutElements = MakeArrayView(reinterpret_cast<const ElementType*>(Data + Range.Offset), int32(Range.Num));
+	return true;
+}
+
+// Every index of the map is in range, so a corrupted or tampered file can not send the readers of the view out of bounds
+static bool HasValidIndices(const FMapGenerationView& View)
+{
+	const int32 NumPoints = View.GeneratedPoints.Num();
+	const int32 NumNodes = View.Paths.Num();
+	const int32 NumHalfEdges = View.HalfEdgeTwins.Num();
+
+	for (const FGeneratedTriangle& Triangle : View.Triangles)
+	{
+		for (int32 Corner = 0; Corner < 3; ++Corner)
+		{
+			if (uint32(Triangle[Corner]) >= uint32(NumPoints))
+			{
+				return false;
+			}
+		}
+	}
+
+	for (const int32 Twin : View.HalfEdgeTwins)
+	{
+		if (Twin < INDEX_NONE || Twin >= NumHalfEdges)
+		{
+			return false;
+		}
+	}
+
+	for (const FGeneratedEdge& Edge : View.Edges)
+	{
+		if (uint32(Edge.StartVertex) >= uint32(NumPoints) || uint32(Edge.EndVertex) >= uint32(NumPoints))
+		{
+			return false;
+		}
+	}
+
+	for (const FGeneratedNode& Node : View.Paths)
+	{
+		if (Node.FirstChildNode < 0 || Node.NumChildNodes < 0 || Node.NumChildNodes > View.PathChildNodes.Num() - Node.FirstChildNode
+			|| Node.ParentNode < INDEX_NONE || Node.ParentNode >= NumNodes)
+		{
+			return false;
+		}
+	}
+
+	for (const int32 Child : View.PathChildNodes)
+	{
+		if (uint32(Child) >= uint32(NumNodes))
+		{
+			return false;
+		}
+	}
+
+	for (const int32 RouteNode : View.Routes)
+	{
+		if (uint32(RouteNode) >= uint32(NumNodes))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+FMapGenerationCacheFile::FMapGenerationCacheFile(TUniquePtr<IMappedFileHandle>&& InHandle, TUniquePtr<IMappedFileRegion>&& InRegion) :
+	Handle(MoveTemp(InHandle)),
+	Region(MoveTemp(InRegion))
+{
+}
+
+FMapGenerationCacheFile::~FMapGenerationCacheFile()
+{
+	// The region has to be unmapped before its file is closed
+	Region.Reset();
+	Handle.Reset();
+}
+
+FMapGenerationCache::FMapGenerationCache(const FString& InDirectory) :
+	Directory(InDirectory)
+{
+}
+
+FSHAHash FMapGenerationCache::HashSettings(const FMapGenerationSettings& Settings)
+{
+	const uint8 bParallelSampling = Settings.bParallelSampling ? 1 : 0;
+
+	FSHA1 Hasher;
+	Hasher.Update(reinterpret_cast<const uint8*>(&FormatVersion), sizeof(FormatVersion));
+	Hasher.Update(reinterpret_cast<const uint8*>(&Settings.Seed), sizeof(Settings.Seed));
+	Hasher.Update(reinterpret_cast<const uint8*>(&Settings.GridExtend), sizeof(Settings.GridExtend));
+	Hasher.Update(reinterpret_cast<const uint8*>(&Settings.SphereRadius), sizeof(Settings.SphereRadius));
+	Hasher.Update(reinterpret_cast<const uint8*>(&Settings.Iterations), sizeof(Settings.Iterations));
+	Hasher.Update(reinterpret_cast<const uint8*>(&Settings.NumSampleBeforeRejection), sizeof(Settings.NumSampleBeforeRejection));
+	// The tiled sampling generates other points, the parallel triangulation only orders the same triangles differently
+	Hasher.Update(&bParallelSampling, sizeof(bParallelSampling));
+	Hasher.Final();
+
+	FSHAHash Hash;
+	Hasher.GetHash(Hash.Hash);
+	return Hash;
+}
+
+FString FMapGenerationCache::GetFilename(const FMapGenerationSettings& Settings) const
+{
+	return FPaths::Combine(Directory, HashSettings(Settings).ToString() + TEXT(".mapcache"));
+}
+
+bool FMapGenerationCache::Save(const FMapGenerationSettings& Settings, const FMapGenerationView& View) const
+{
+	FMapCacheHeader Header;
+	FMemory::Memzero(Header);
+
+	Header.Magic = MapCacheMagic;
+	Header.Version = FormatVersion;
+	FMemory::Memcpy(Header.SettingsHash, HashSettings(Settings).Hash, sizeof(Header.SettingsHash));
+	Header.StartPointIndex = View.StartPointIndex;
+	Header.EndPointIndex = View.EndPointIndex;
+	Header.StartPoint = View.StartPoint;
+	Header.EndPoint = View.EndPoint;
+
+	const int64 DataSize = View.GeneratedPoints.Num() * sizeof(FVector2D) + View.Triangles.Num() * sizeof(FGeneratedTriangle) + View.HalfEdgeTwins.Num() * sizeof(int32)
+		+ View.Edges.Num() * sizeof(FGeneratedEdge) + View.Paths.Num() * sizeof(FGeneratedNode) + (View.PathChildNodes.Num() + View.Routes.Num()) * sizeof(int32);
+
+	TArray<uint8> Buffer;
+	Buffer.Reserve(sizeof(FMapCacheHeader) + DataSize + uint32(EMapCacheSection::Num) * MapCacheAlignment);
+	Buffer.SetNumZeroed(sizeof(FMapCacheHeader));
+
+	WriteSection(Buffer, Header, EMapCacheSection::GeneratedPoints, View.GeneratedPoints);
+	WriteSection(Buffer, Header, EMapCacheSection::Triangles, View.Triangles);
+	WriteSection(Buffer, Header, EMapCacheSection::HalfEdgeTwins, View.HalfEdgeTwins);
+	WriteSection(Buffer, Header, EMapCacheSection::Edges, View.Edges);
+	WriteSection(Buffer, Header, EMapCacheSection::Paths, View.Paths);
+	WriteSection(Buffer, Header, EMapCacheSection::PathChildNodes, View.PathChildNodes);
+	WriteSection(Buffer, Header, EMapCacheSection::Routes, View.Routes);
+
+	FMemory::Memcpy(Buffer.GetData(), &Header, sizeof(Header));
+
+	IFileManager& FileManager = IFileManager::Get();
+	FileManager.MakeDirectory(*Directory, true);
+
+	const FString TempFilename = FPaths::CreateTempFilename(*Directory, TEXT("MapCache"), TEXT(".tmp"));
+
+	if (!FFileHelper::SaveArrayToFile(Buffer, *TempFilename))
+	{
+		return false;
+	}
+
+	// Fails while another cache file object still maps the previous file on some platforms, it is saved again next time
+	if (!FileManager.Move(*GetFilename(Settings), *TempFilename, true, false, false, true))
+	{
+		FileManager.Delete(*TempFilename);
+		return false;
+	}
+
+	return true;
+}
+
+TUniquePtr<FMapGenerationCacheFile> FMapGenerationCache::Load(const FMapGenerationSettings& Settings) const
+{
+	const FString Filename = GetFilename(Settings);
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	if (!PlatformFile.FileExists(*Filename))
+	{
+		return nullptr;
+	}
+
+	TUniquePtr<IMappedFileHandle> Handle(PlatformFile.OpenMapped(*Filename));
+
+	if (!Handle.IsValid() || Handle->GetFileSize() < int64(sizeof(FMapCacheHeader)))
+	{
+		return nullptr;
+	}
+
+	TUniquePtr<IMappedFileRegion> Region(Handle->MapRegion(0, Handle->GetFileSize()));
+
+	if (!Region.IsValid())
+	{
+		return nullptr;
+	}
+
+	const uint8* Data = Region->GetMappedPtr();
+	const uint64 Size = Region->GetMappedSize();
+
+	FMapCacheHeader Header;
+	FMemory::Memcpy(&Header, Data, sizeof(Header));
+
+	if (Header.Magic != MapCacheMagic || Header.Version != FormatVersion || FMemory::Memcmp(Header.SettingsHash, HashSettings(Settings).Hash, sizeof(Header.SettingsHash)) != 0)
+	{
+		return nullptr;
+	}
+
+	FMapGenerationView View;
+	View.StartPoint = Header.StartPoint;
+	View.EndPoint = Header.EndPoint;
+	View.StartPointIndex = Header.StartPointIndex;
+	View.EndPointIndex = Header.EndPointIndex;
+
+	const bool bValidSections = ReadSection(Data, Size, Header, EMapCacheSection::GeneratedPoints, View.GeneratedPoints)
+		&& ReadSection(Data, Size, Header, EMapCacheSection::Triangles, View.Triangles)
+		&& ReadSection(Data, Size, Header, EMapCacheSection::HalfEdgeTwins, View.HalfEdgeTwins)
+		&& ReadSection(Data, Size, Header, EMapCacheSection::Edges, View.Edges)
+		&& ReadSection(Data, Size, Header, EMapCacheSection::Paths, View.Paths)
+		&& ReadSection(Data, Size, Header, EMapCacheSection::PathChildNodes, View.PathChildNodes)
+		&& ReadSection(Data, Size, Header, EMapCacheSection::Routes, View.Routes);
+
+	const bool bValidMap = bValidSections
+		&& View.HalfEdgeTwins.Num() == 3 * View.Triangles.Num()
+		&& (View.Paths.Num() == 0 || View.Paths.Num() == View.GeneratedPoints.Num())
+		&& (View.StartPointIndex == INDEX_NONE || View.GeneratedPoints.IsValidIndex(View.StartPointIndex))
+		&& (View.EndPointIndex == INDEX_NONE || View.GeneratedPoints.IsValidIndex(View.EndPointIndex))
+		&& HasValidIndices(View);
+
+	// A rejected file is generated again and overwritten
+	if (!bValidMap)
+	{
+		return nullptr;
+	}
+
+	TUniquePtr<FMapGenerationCacheFile> File(new FMapGenerationCacheFile(MoveTemp(Handle), MoveTemp(Region)));
+	File->View = View;
+	return File;
+}
@@ -0,0 +1,939 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MapGenerationPipeline.h"
+#include "Triangulation/CircumCircleCache.h"
+#include "Triangulation/DelaunayTriangulation.h"
+#include "Async/ParallelFor.h"
+#include <atomic>
+
+DECLARE_CYCLE_STAT(TEXT("Poisson Disk Sampling"), STAT_MapGeneration_PoissonDiskSampling, STATGROUP_MapGeneration);
+DECLARE_CYCLE_STAT(TEXT("Sample Tile"), STAT_MapGeneration_SampleTile, STATGROUP_MapGeneration);
+DECLARE_CYCLE_STAT(TEXT("Delaunay Triangulation"), STAT_MapGeneration_DelaunayTriangulation, STATGROUP_MapGeneration);
+DECLARE_CYCLE_STAT(TEXT("Build Edges"), STAT_MapGeneration_BuildEdges, STATGROUP_MapGeneration);
+DECLARE_CYCLE_STAT(TEXT("Generate Paths"), STAT_MapGeneration_GeneratePaths, STATGROUP_MapGeneration);
+DECLARE_CYCLE_STAT(TEXT("Find Routes"), STAT_MapGeneration_FindRoutes, STATGROUP_MapGeneration);
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Tested Candidates"), STAT_MapGeneration_TestedCandidates, STATGROUP_MapGeneration);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Accepted Candidates"), STAT_MapGeneration_AcceptedCandidates, STATGROUP_MapGeneration);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Rejected Candidates"), STAT_MapGeneration_RejectedCandidates, STATGROUP_MapGeneration);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Created Triangles"), STAT_MapGeneration_CreatedTriangles, STATGROUP_MapGeneration);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Removed Triangles"), STAT_MapGeneration_RemovedTriangles, STATGROUP_MapGeneration);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Max Cavity Triangles"), STAT_MapGeneration_MaxCavityTriangles, STATGROUP_MapGeneration);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Expanded Route Nodes"), STAT_MapGeneration_ExpandedNodes, STATGROUP_MapGeneration);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Max Open Route Nodes"), STAT_MapGeneration_MaxOpenNodes, STATGROUP_MapGeneration);
+
+// Side of the parallel sampling tiles, in grid cells
+static constexpr int32 SamplingTileCells = 32;
+
+// Cells around a tile holding samples that can spawn candidates into it, a candidate lands at most two radius (2.83 cells) away
+static constexpr int32 SamplingReachCells = 3;
+
+// Writes the seconds spent in its scope to Time, whichever way the scope is left
+struct FMapStageTimer
+{
+	explicit FMapStageTimer(double& InTime) :
+		Time(InTime),
+		StartTime(FPlatformTime::Seconds())
+	{
+	}
+
+	~FMapStageTimer()
+	{
+		Time = FPlatformTime::Seconds() - StartTime;
+	}
+
+	double& Time;
+	double StartTime;
+};
+
+FMapGenerationPipeline::FMapGenerationPipeline()
+{
+}
+
+FMapGenerationPipeline::FMapGenerationPipeline(const FMapGenerationSettings& InSettings) :
+	Settings(InSettings)
+{
+}
+
+void FMapGenerationPipeline::Generate()
+{
+	PoisonDiskSampling();
+	DelaunaryTriangulation();
+	GeneratePaths();
+	FindRoutes();
+}
+
+void FMapGenerationPipeline::PoisonDiskSampling()
+{
+	SCOPE_CYCLE_COUNTER(STAT_MapGeneration_PoissonDiskSampling);
+
+	Stats.Sampling = FMapSamplingStats();
+	FMapStageTimer Timer(Stats.Sampling.Time);
+
+	Random = FRandomStream(Settings.Seed);
+
+	const float GridExtend = Settings.GridExtend;
+	const float SphereRadius = Settings.SphereRadius;
+
+	const float CellSize = SphereRadius / FMath::Sqrt(2.0f);
+
+	GeneratedPoints.Reset(0);
+	Grid.Init(GridExtend, CellSize);
+
+	int Iterations = Settings.Iterations;
+	if (Iterations < 0 || Iterations >= MAX_int32)
+	{
+		Iterations = MAX_int32;
+	}
+
+	if (Settings.bParallelSampling)
+	{
+		PoisonDiskSamplingTiles(Iterations);
+	}
+	else
+	{
+		TArray<FVector2D> SpawnPoints;
+
+		//StartedPoint, we try with the middle point
+		FVector2D StartedPoint = FVector2D(GridExtend / 2.0f, GridExtend / 2.0f);
+		SpawnPoints.Add(StartedPoint);
+
+		SampleFromSpawnPoints(Random, SpawnPoints, FIntPoint(0), FIntPoint(Grid.GetNumCells()), Iterations, GeneratedPoints, Stats.Sampling);
+	}
+
+	if (Settings.bCheckWellGenerated)
+	{
+		for (int Index = 0; Index < GeneratedPoints.Num() - 1; ++Index)
+		{
+			FVector2D Pos = GeneratedPoints[Index];
+
+			for (int NextIndex = Index + 1; NextIndex < GeneratedPoints.Num(); ++NextIndex)
+			{
+				FVector2D NextPos = GeneratedPoints[NextIndex];
+
+				FVector2D Dist = NextPos - Pos;
+				float SqrtDistance = Dist.SizeSquared();
+
+				if (SqrtDistance < SphereRadius * SphereRadius)
+				{
+					UE_LOG(LogTemp, Warning, TEXT("Bad Disck Noise Sample"));
+				}
+			}
+		}
+	}
+
+	StartPoint = FVector2D(-10.0f, GridExtend / 2.0f);
+	EndPoint = FVector2D(GridExtend + 10.0f, GridExtend / 2.0f);
+
+	StartPointIndex = GeneratedPoints.Add(StartPoint);
+	EndPointIndex = GeneratedPoints.Add(EndPoint);
+
+	bEditableTriangulation = false;
+
+	SET_DWORD_STAT(STAT_MapGeneration_TestedCandidates, Stats.Sampling.NumTestedCandidates);
+	SET_DWORD_STAT(STAT_MapGeneration_AcceptedCandidates, Stats.Sampling.NumAcceptedCandidates);
+	SET_DWORD_STAT(STAT_MapGeneration_RejectedCandidates, Stats.Sampling.NumRejectedCandidates);
+}
+
+void FMapGenerationPipeline::PoisonDiskSamplingCells(FRandomStream& Stream, TConstArrayView<FVector2D> FixedPoints, const FIntPoint& MinCell, const FIntPoint& EndCell, TArray<FVector2D>& OutPoints)
+{
+	Grid.Init(Settings.GridExtend, Settings.SphereRadius / FMath::Sqrt(2.0f));
+
+	for (const FVector2D& FixedPoint : FixedPoints)
+	{
+		if (Grid.IsInside(FixedPoint))
+		{
+			Grid.Add(FixedPoint);
+		}
+	}
+
+	int Iterations = Settings.Iterations;
+	if (Iterations < 0 || Iterations >= MAX_int32)
+	{
+		Iterations = MAX_int32;
+	}
+
+	// Same growth as a tile of the parallel sampling
+	TArray<FVector2D> SpawnPoints;
+	SpawnPoints.Add(FVector2D(MinCell + EndCell) * (0.5 * Grid.GetCellSize()));
+	Grid.GatherSamples(MinCell - FIntPoint(SamplingReachCells), EndCell + FIntPoint(SamplingReachCells), SpawnPoints);
+
+	Stats.Sampling = FMapSamplingStats();
+	SampleFromSpawnPoints(Stream, SpawnPoints, MinCell, EndCell, Iterations, OutPoints, Stats.Sampling);
+}
+
+void FMapGenerationPipeline::PoisonDiskSamplingTiles(int Iterations)
+{
+	const int32 NumCells = Grid.GetNumCells();
+	const int32 NumTilesPerSide = FMath::DivideAndRoundUp(NumCells, SamplingTileCells);
+	const int32 NumTiles = NumTilesPerSide * NumTilesPerSide;
+
+	const int32 NumThreads = Settings.NumSamplingThreads > 0 ? Settings.NumSamplingThreads : FPlatformMisc::NumberOfCoresIncludingHyperthreads();
+	const int TileIterations = Iterations == MAX_int32 ? MAX_int32 : FMath::Max(1, Iterations / NumTiles);
+
+	TArray<TArray<FVector2D>> TilePoints;
+	TilePoints.SetNum(NumTiles);
+
+	// Summed once every tile is done, so the threads never share a counter
+	TArray<FMapSamplingStats> TileStats;
+	TileStats.SetNum(NumTiles);
+
+	TArray<int32> PhaseTiles;
+	PhaseTiles.Reserve(NumTiles / 4 + NumTilesPerSide + 1);
+
+	// Tiles of the same phase are a whole tile apart, further than any sample can reach, so they never touch the same cells.
+	// Each tile has its own random stream and the tiles are gathered in order, so the result does not depend on the threads.
+	for (int32 Phase = 0; Phase < 4; ++Phase)
+	{
+		PhaseTiles.Reset();
+
+		for (int32 TileX = Phase % 2; TileX < NumTilesPerSide; TileX += 2)
+		{
+			for (int32 TileY = Phase / 2; TileY < NumTilesPerSide; TileY += 2)
+			{
+				PhaseTiles.Add(TileX * NumTilesPerSide + TileY);
+			}
+		}
+
+		std::atomic<int32> NextPhaseTile(0);
+		const int32 NumTasks = FMath::Clamp(NumThreads, 1, PhaseTiles.Num());
+
+		ParallelFor(NumTasks, [&](int32 TaskIndex)
+		{
+			for (int32 PhaseTile = NextPhaseTile++; PhaseTile < PhaseTiles.Num(); PhaseTile = NextPhaseTile++)
+			{
+				SCOPE_CYCLE_COUNTER(STAT_MapGeneration_SampleTile);
+
+				const int32 Tile = PhaseTiles[PhaseTile];
+				const FIntPoint MinCell = FIntPoint(Tile / NumTilesPerSide, Tile % NumTilesPerSide) * SamplingTileCells;
+				const FIntPoint EndCell = FIntPoint(FMath::Min(MinCell.X + SamplingTileCells, NumCells), FMath::Min(MinCell.Y + SamplingTileCells, NumCells));
+
+				FRandomStream TileRandom(int32(HashCombine(GetTypeHash(Settings.Seed), GetTypeHash(Tile))));
+
+				// Grow from the tile centre and from the samples of the earlier phases that can reach into the tile
+				TArray<FVector2D> SpawnPoints;
+				SpawnPoints.Add(FVector2D(MinCell + EndCell) * (0.5 * Grid.GetCellSize()));
+				Grid.GatherSamples(MinCell - FIntPoint(SamplingReachCells), EndCell + FIntPoint(SamplingReachCells), SpawnPoints);
+
+				SampleFromSpawnPoints(TileRandom, SpawnPoints, MinCell, EndCell, TileIterations, TilePoints[Tile], TileStats[Tile]);
+			}
+		});
+	}
+
+	int32 NumPoints = 0;
+	for (const TArray<FVector2D>& Points : TilePoints)
+	{
+		NumPoints += Points.Num();
+	}
+
+	GeneratedPoints.Reserve(NumPoints + 2);
+
+	for (const TArray<FVector2D>& Points : TilePoints)
+	{
+		GeneratedPoints.Append(Points);
+	}
+
+	for (const FMapSamplingStats& Tile : TileStats)
+	{
+		Stats.Sampling.Accumulate(Tile);
+	}
+}
+
+void FMapGenerationPipeline::SampleFromSpawnPoints(FRandomStream& Stream, TArray<FVector2D>& SpawnPoints, const FIntPoint& MinCell, const FIntPoint& EndCell, int Iterations, TArray<FVector2D>& OutPoints, FMapSamplingStats& OutStats)
+{
+	const float SphereRadius = Settings.SphereRadius;
+
+	// Counted locally and added once, the loop below is the hottest of the sampling
+	int64 NumTestedCandidates = 0;
+	int64 NumAcceptedCandidates = 0;
+	int64 NumRetiredSpawnPoints = 0;
+
+	while (SpawnPoints.Num() > 0 && Iterations > 0)
+	{
+		const int RandomSpawnIndex = Stream.RandRange(0, SpawnPoints.Num() - 1);
+		const FVector2D SpawnRandomPoint = SpawnPoints[RandomSpawnIndex];
+
+		bool bCandidateAccepted = false;
+
+		auto AcceptCandidate = [this, &OutPoints, &SpawnPoints, &bCandidateAccepted](const FVector2D& CandidatePoint)
+		{
+			OutPoints.Add(CandidatePoint);
+			SpawnPoints.Add(CandidatePoint);
+
+			Grid.Add(CandidatePoint);
+			bCandidateAccepted = true;
+		};
+
+		if (Settings.bBatchCandidateTests)
+		{
+			// The random stream is rewound to right after the accepted candidate, so the output matches testing them one by one
+			for (int FirstIndex = 0; FirstIndex < Settings.NumSampleBeforeRejection && !bCandidateAccepted; FirstIndex += FSampleGrid::BatchSize)
+			{
+				const int NumCandidates = FMath::Min(FSampleGrid::BatchSize, Settings.NumSampleBeforeRejection - FirstIndex);
+
+				FVector2D Candidates[FSampleGrid::BatchSize];
+				FRandomStream RandomAfterCandidates[FSampleGrid::BatchSize];
+
+				for (int Index = 0; Index < NumCandidates; ++Index)
+				{
+					Candidates[Index] = GenerateCandidate(Stream, SpawnRandomPoint);
+					RandomAfterCandidates[Index] = Stream;
+
+					if (!Grid.IsInsideCells(Candidates[Index], MinCell, EndCell))
+					{
+						Candidates[Index] = FVector2D(-1.0f);
+					}
+				}
+
+				const int32 CandidateIndex = Grid.FindFirstFreePosition(Candidates, NumCandidates, SphereRadius);
+
+				if (CandidateIndex != INDEX_NONE)
+				{
+					Stream = RandomAfterCandidates[CandidateIndex];
+					AcceptCandidate(Candidates[CandidateIndex]);
+				}
+
+				NumTestedCandidates += CandidateIndex != INDEX_NONE ? CandidateIndex + 1 : NumCandidates;
+			}
+		}
+		else
+		{
+			for (int Index = 0; Index < Settings.NumSampleBeforeRejection; ++Index)
+			{
+				const FVector2D CandidatePoint = GenerateCandidate(Stream, SpawnRandomPoint);
+				++NumTestedCandidates;
+
+				if (Grid.IsInsideCells(CandidatePoint, MinCell, EndCell) && IsCandidateValid(CandidatePoint))
+				{
+					AcceptCandidate(CandidatePoint);
+					break;
+				}
+			}
+		}
+
+		if (bCandidateAccepted)
+		{
+			++NumAcceptedCandidates;
+		}
+		else
+		{
+			SpawnPoints.RemoveAt(RandomSpawnIndex);
+			++NumRetiredSpawnPoints;
+		}
+		Iterations -= 1;
+	}
+
+	OutStats.NumTestedCandidates += NumTestedCandidates;
+	OutStats.NumAcceptedCandidates += NumAcceptedCandidates;
+	OutStats.NumRejectedCandidates += NumTestedCandidates - NumAcceptedCandidates;
+	OutStats.NumRetiredSpawnPoints += NumRetiredSpawnPoints;
+}
+
+FVector2D FMapGenerationPipeline::GenerateCandidate(FRandomStream& Stream, const FVector2D& SpawnPoint) const
+{
+	const float PISimplified = 3.141592654f;
+
+	const float Angle = Stream.FRand() * PISimplified * 2;
+	const FVector2D Direction = FVector2D(FMath::Sin(Angle), FMath::Cos(Angle));
+	return SpawnPoint + Direction * Stream.RandRange(Settings.SphereRadius, Settings.SphereRadius * 2.0f);
+}
+
+bool FMapGenerationPipeline::IsCandidateValid(const FVector2D& Candidate) const
+{
+	return Grid.IsInside(Candidate) && !Grid.HasSampleCloserThan(Candidate, Settings.SphereRadius);
+}
+
+void FMapGenerationPipeline::DelaunaryTriangulation()
+{
+	SCOPE_CYCLE_COUNTER(STAT_MapGeneration_DelaunayTriangulation);
+
+	FMapStageTimer Timer(Stats.Triangulation.Time);
+
+	if (Settings.bParallelTriangulation)
+	{
+		const int32 NumThreads = Settings.NumTriangulationThreads > 0 ? Settings.NumTriangulationThreads : FPlatformMisc::NumberOfCoresIncludingHyperthreads();
+		ParallelTriangulation.Triangulate(GeneratedPoints, NumThreads, Triangles, HalfEdgeTwins);
+		Stats.Triangulation = ParallelTriangulation.GetStats();
+		bEditableTriangulation = false;
+	}
+	else
+	{
+		Triangulation.Triangulate(GeneratedPoints);
+		Triangulation.ExportTriangles(Triangles, HalfEdgeTwins);
+		Stats.Triangulation = Triangulation.GetStats();
+		bEditableTriangulation = true;
+	}
+
+	SET_DWORD_STAT(STAT_MapGeneration_CreatedTriangles, Stats.Triangulation.NumCreatedTriangles);
+	SET_DWORD_STAT(STAT_MapGeneration_RemovedTriangles, Stats.Triangulation.NumRemovedTriangles);
+	SET_DWORD_STAT(STAT_MapGeneration_MaxCavityTriangles, Stats.Triangulation.MaxCavityTriangles);
+
+	BuildEdges();
+}
+
+void FMapGenerationPipeline::BuildEdges()
+{
+	SCOPE_CYCLE_COUNTER(STAT_MapGeneration_BuildEdges);
+
+	const int NumPoints = GeneratedPoints.Num();
+
+	bEdgesOutdated = false;
+
+	// Bucket every triangle side by its lower point, a side shared by two triangles lands twice in the same bucket
+	TArray<int32> SideOffsets;
+	SideOffsets.SetNumZeroed(NumPoints + 1);
+
+	for (const FGeneratedTriangle& Triangle : Triangles)
+	{
+		for (int Corner = 0; Corner < 3; ++Corner)
+		{
+			++SideOffsets[FMath::Min(Triangle[Corner], Triangle[(Corner + 1) % 3]) + 1];
+		}
+	}
+
+	for (int Vertex = 0; Vertex < NumPoints; ++Vertex)
+	{
+		SideOffsets[Vertex + 1] += SideOffsets[Vertex];
+	}
+
+	TArray<int32> SideCursors = SideOffsets;
+	TArray<int32> SideEnds;
+	SideEnds.SetNumUninitialized(3 * Triangles.Num());
+
+	for (const FGeneratedTriangle& Triangle : Triangles)
+	{
+		for (int Corner = 0; Corner < 3; ++Corner)
+		{
+			const int32 Start = Triangle[Corner];
+			const int32 End = Triangle[(Corner + 1) % 3];
+			SideEnds[SideCursors[FMath::Min(Start, End)]++] = FMath::Max(Start, End);
+		}
+	}
+
+	Edges.Reset(SideEnds.Num() / 2 + NumPoints);
+
+	for (int Vertex = 0; Vertex < NumPoints; ++Vertex)
+	{
+		// Buckets only hold a handful of sides, an insertion sort is enough to order and dedupe them
+		const int32 BucketStart = SideOffsets[Vertex];
+		const int32 BucketEnd = SideOffsets[Vertex + 1];
+
+		for (int32 Index = BucketStart + 1; Index < BucketEnd; ++Index)
+		{
+			const int32 End = SideEnds[Index];
+			int32 Slot = Index;
+
+			for (; Slot > BucketStart && SideEnds[Slot - 1] > End; --Slot)
+			{
+				SideEnds[Slot] = SideEnds[Slot - 1];
+			}
+
+			SideEnds[Slot] = End;
+		}
+
+		for (int32 Index = BucketStart; Index < BucketEnd; ++Index)
+		{
+			if (Index == BucketStart || SideEnds[Index] != SideEnds[Index - 1])
+			{
+				Edges.Add(FGeneratedEdge(Vertex, SideEnds[Index]));
+			}
+		}
+	}
+
+	BuildVertexEdges();
+}
+
+void FMapGenerationPipeline::BuildVertexEdges()
+{
+	const int NumPoints = GeneratedPoints.Num();
+
+	// Point to edge adjacency in compressed rows
+	VertexEdgeOffsets.Reset(NumPoints + 1);
+	VertexEdgeOffsets.SetNumZeroed(NumPoints + 1);
+
+	for (const FGeneratedEdge& Edge : Edges)
+	{
+		++VertexEdgeOffsets[Edge.StartVertex + 1];
+		++VertexEdgeOffsets[Edge.EndVertex + 1];
+	}
+
+	for (int Vertex = 0; Vertex < NumPoints; ++Vertex)
+	{
+		VertexEdgeOffsets[Vertex + 1] += VertexEdgeOffsets[Vertex];
+	}
+
+	TArray<int32> EdgeCursors = VertexEdgeOffsets;
+	VertexEdges.SetNumUninitialized(2 * Edges.Num());
+
+	for (int32 EdgeIndex = 0; EdgeIndex < Edges.Num(); ++EdgeIndex)
+	{
+		VertexEdges[EdgeCursors[Edges[EdgeIndex].StartVertex]++] = EdgeIndex;
+		VertexEdges[EdgeCursors[Edges[EdgeIndex].EndVertex]++] = EdgeIndex;
+	}
+}
+
+void FMapGenerationPipeline::DelaunaryTriangulationBowyerWatson()
+{
+	Triangles.Reset(0);
+	HalfEdgeTwins.Reset(0);
+
+	if (GeneratedPoints.Num() > 0)
+	{
+		// The super triangle vertices go after the generated points
+		const int NumPoints = GeneratedPoints.Num();
+		TArray<FVector2D> Points = GeneratedPoints;
+
+		FVector2D LeftVertex, RightVertex, UpVertex;
+		FDelaunayTriangulation::ComputeSuperTriangle(GeneratedPoints, LeftVertex, RightVertex, UpVertex);
+		Points.Add(LeftVertex);
+		Points.Add(RightVertex);
+		Points.Add(UpVertex);
+
+		FGeneratedTriangle SuperTriangle = FGeneratedTriangle(NumPoints, NumPoints + 1, NumPoints + 2);
+
+		Triangles.Add(SuperTriangle);
+
+		// Circumcircles of Triangles in the same order, so each insertion only confirms the few triangles near the point
+		FCircumCircleCache CircumCircles;
+		CircumCircles.Add(LeftVertex, RightVertex, UpVertex);
+
+		TArray<int32> CandidateTriangles;
+		TArray<bool> BadTriangles;
+		TArray<bool> BadPolygons;
+
+		for (int Index = 0; Index < NumPoints; ++Index)
+		{
+			TArray<FGeneratedEdge> Polygons;
+			BadTriangles.Init(false, Triangles.Num());
+
+			CandidateTriangles.Reset();
+			CircumCircles.FindContaining(Points[Index], CandidateTriangles);
+
+			for (const int32 TriangleIndex : CandidateTriangles)
+			{
+				if (Triangles[TriangleIndex].CircumCircleContains(Points, Points[Index]))
+				{
+					BadTriangles[TriangleIndex] = true;
+
+					Polygons.Add(FGeneratedEdge(Triangles[TriangleIndex].Vertex1, Triangles[TriangleIndex].Vertex2));
+					Polygons.Add(FGeneratedEdge(Triangles[TriangleIndex].Vertex2, Triangles[TriangleIndex].Vertex3));
+					Polygons.Add(FGeneratedEdge(Triangles[TriangleIndex].Vertex3, Triangles[TriangleIndex].Vertex1));
+				}
+			}
+
+			int NumKeptTriangles = 0;
+
+			for (int TriangleIndex = 0; TriangleIndex < Triangles.Num(); ++TriangleIndex)
+			{
+				if (!BadTriangles[TriangleIndex])
+				{
+					Triangles[NumKeptTriangles++] = Triangles[TriangleIndex];
+				}
+			}
+
+			Triangles.SetNum(NumKeptTriangles, false);
+			CircumCircles.RemoveFlagged(BadTriangles);
+
+			BadPolygons.Init(false, Polygons.Num());
+
+			for (int PolygonIndex = 0; PolygonIndex < Polygons.Num(); ++PolygonIndex)
+			{
+				for (int NextPolygonIndex = PolygonIndex + 1; NextPolygonIndex < Polygons.Num(); ++NextPolygonIndex)
+				{
+					FGeneratedEdge A = Polygons[PolygonIndex];
+					FGeneratedEdge B = Polygons[NextPolygonIndex];
+
+					if ((A.StartVertex == B.StartVertex && A.EndVertex == B.EndVertex) || (A.StartVertex == B.EndVertex && A.EndVertex == B.StartVertex))
+					{
+						BadPolygons[PolygonIndex] = true;
+						BadPolygons[NextPolygonIndex] = true;
+					}
+				}
+			}
+
+			for (int PolygonIndex = 0; PolygonIndex < Polygons.Num(); ++PolygonIndex)
+			{
+				if (!BadPolygons[PolygonIndex])
+				{
+					Triangles.Add(FGeneratedTriangle(Polygons[PolygonIndex].StartVertex, Polygons[PolygonIndex].EndVertex, Index));
+					CircumCircles.Add(Points[Polygons[PolygonIndex].StartVertex], Points[Polygons[PolygonIndex].EndVertex], Points[Index]);
+				}
+			}
+		}
+
+		//Remove Triangles that have conections with the super triangle
+		for (int TriangleIndex = 0; TriangleIndex < Triangles.Num(); ++TriangleIndex)
+		{
+			const FGeneratedTriangle& Triangle = Triangles[TriangleIndex];
+
+			if (Triangle.Vertex1 >= NumPoints || Triangle.Vertex2 >= NumPoints || Triangle.Vertex3 >= NumPoints)
+			{
+				Triangles.RemoveAt(TriangleIndex);
+				TriangleIndex -= 1;
+			}
+		}
+
+	}
+
+	bEditableTriangulation = false;
+
+	BuildEdges();
+}
+
+void FMapGenerationPipeline::GeneratePaths()
+{
+	SCOPE_CYCLE_COUNTER(STAT_MapGeneration_GeneratePaths);
+
+	Stats.Paths = FMapPathStats();
+	FMapStageTimer Timer(Stats.Paths.Time);
+
+	Paths.Reset(0);
+	PathChildNodes.Reset(0);
+	NumStalePathChildNodes = 0;
+
+	if (GeneratedPoints.Num() < 2)
+	{
+		return;
+	}
+
+	const int NumPoints = GeneratedPoints.Num();
+
+	if (bEdgesOutdated)
+	{
+		BuildEdges();
+		Stats.Paths.bRebuiltEdges = true;
+	}
+
+	//Pre generate the points on Path, StartPoint and EndPoint included
+	Paths.SetNum(NumPoints);
+
+	for (int Index = 0; Index < NumPoints; ++Index)
+	{
+		Paths[Index].NodePosition = GeneratedPoints[Index];
+	}
+
+	Stats.Paths.NumNodes = NumPoints;
+
+	// Nodes stay unlinked until the points are triangulated
+	if (VertexEdgeOffsets.Num() != NumPoints + 1)
+	{
+		return;
+	}
+
+	// An edge links at most one of its two nodes to the other, so every child fits in a single allocation
+	PathChildNodes.Reserve(Edges.Num());
+
+	for (int Index = 0; Index < NumPoints; ++Index)
+	{
+		const FVector2D& NodePosition = Paths[Index].NodePosition;
+
+		Paths[Index].FirstChildNode = PathChildNodes.Num();
+
+		// Edges are unique, so a neighbour can only be found once
+		for (int32 Offset = VertexEdgeOffsets[Index]; Offset < VertexEdgeOffsets[Index + 1]; ++Offset)
+		{
+			const FGeneratedEdge& Edge = Edges[VertexEdges[Offset]];
+			const int EdgePoint = Edge.StartVertex == Index ? Edge.EndVertex : Edge.StartVertex;
+
+			if ((GeneratedPoints[EdgePoint].X - NodePosition.X) > Settings.SphereRadius / 3.0f)
+			{
+				PathChildNodes.Add(EdgePoint);
+				Paths[EdgePoint].ParentNode = Index;
+			}
+		}
+
+		Paths[Index].NumChildNodes = PathChildNodes.Num() - Paths[Index].FirstChildNode;
+	}
+
+	Stats.Paths.NumChildLinks = PathChildNodes.Num();
+}
+
+void FMapGenerationPipeline::FindRoutes()
+{
+	SCOPE_CYCLE_COUNTER(STAT_MapGeneration_FindRoutes);
+
+	Stats.Route = FMapRouteStats();
+	FMapStageTimer Timer(Stats.Route.Time);
+
+	Routes.Reset(0);
+
+	if (Paths.Num() == 0)
+	{
+		return;
+	}
+
+	RouteSearch.FindRoute(Paths, PathChildNodes, StartPointIndex, EndPointIndex, Routes);
+
+	Stats.Route.NumExpandedNodes = RouteSearch.GetNumExpandedNodes();
+	Stats.Route.MaxOpenNodes = RouteSearch.GetMaxOpenNodes();
+	Stats.Route.NumRouteNodes = Routes.Num();
+
+	SET_DWORD_STAT(STAT_MapGeneration_ExpandedNodes, Stats.Route.NumExpandedNodes);
+	SET_DWORD_STAT(STAT_MapGeneration_MaxOpenNodes, Stats.Route.MaxOpenNodes);
+}
+
+int32 FMapGenerationPipeline::AddPoint(const FVector2D& Position)
+{
+	PrepareEdit();
+
+	const int32 Point = Triangulation.AddPoint(Position);
+
+	if (Point == INDEX_NONE)
+	{
+		return INDEX_NONE;
+	}
+
+	check(Point == GeneratedPoints.Num());
+
+	if (Paths.Num() == GeneratedPoints.Num())
+	{
+		FGeneratedNode PathNode;
+		PathNode.NodePosition = Position;
+		Paths.Add(PathNode);
+	}
+
+	GeneratedPoints.Add(Position);
+
+	FinishEdit(false);
+
+	return Point;
+}
+
+bool FMapGenerationPipeline::RemovePoint(int32 Point)
+{
+	if (!GeneratedPoints.IsValidIndex(Point) || Point == StartPointIndex || Point == EndPointIndex)
+	{
+		return false;
+	}
+
+	PrepareEdit();
+
+	Triangulation.RemovePoint(Point);
+
+	const int32 LastPoint = GeneratedPoints.Num() - 1;
+
+	if (Paths.Num() == GeneratedPoints.Num())
+	{
+		NumStalePathChildNodes += Paths[Point].NumChildNodes;
+		Paths.RemoveAtSwap(Point, 1, false);
+	}
+
+	GeneratedPoints.RemoveAtSwap(Point, 1, false);
+
+	if (StartPointIndex == LastPoint)
+	{
+		StartPointIndex = Point;
+	}
+
+	if (EndPointIndex == LastPoint)
+	{
+		EndPointIndex = Point;
+	}
+
+	FinishEdit(false);
+
+	return true;
+}
+
+bool FMapGenerationPipeline::MovePoint(int32 Point, const FVector2D& NewPosition)
+{
+	if (!GeneratedPoints.IsValidIndex(Point))
+	{
+		return false;
+	}
+
+	PrepareEdit();
+
+	if (!Triangulation.MovePoint(Point, NewPosition))
+	{
+		// The point went back where it was, but it was detached and inserted again, possibly with other neighbours
+		FinishEdit(false);
+		return false;
+	}
+
+	if (Paths.Num() == GeneratedPoints.Num())
+	{
+		Paths[Point].NodePosition = NewPosition;
+	}
+
+	GeneratedPoints[Point] = NewPosition;
+
+	if (Point == StartPointIndex)
+	{
+		StartPoint = NewPosition;
+	}
+
+	if (Point == EndPointIndex)
+	{
+		EndPoint = NewPosition;
+	}
+
+	FinishEdit(Point == StartPointIndex || Point == EndPointIndex);
+
+	return true;
+}
+
+bool FMapGenerationPipeline::SetStartPoint(const FVector2D& Position)
+{
+	return MovePoint(StartPointIndex, Position);
+}
+
+bool FMapGenerationPipeline::SetEndPoint(const FVector2D& Position)
+{
+	return MovePoint(EndPointIndex, Position);
+}
+
+void FMapGenerationPipeline::PrepareEdit()
+{
+	if (bEditableTriangulation)
+	{
+		return;
+	}
+
+	Triangulation.Triangulate(GeneratedPoints);
+	Triangulation.ExportTriangles(Triangles, HalfEdgeTwins);
+	bEditableTriangulation = true;
+
+	BuildEdges();
+
+	// Link the nodes to the same triangles the edits will patch
+	if (Paths.Num() > 0)
+	{
+		GeneratePaths();
+	}
+}
+
+void FMapGenerationPipeline::FinishEdit(bool bEndPointsChanged)
+{
+	Triangulation.UpdateExportedTriangles(Triangles, HalfEdgeTwins, ChangedPoints);
+
+	// Keeping the edges sorted would move most of them, the path links below read the triangulation instead
+	bEdgesOutdated = true;
+
+	if (Paths.Num() != GeneratedPoints.Num())
+	{
+		return;
+	}
+
+	UpdatePathNodes(ChangedPoints);
+
+	bool bRouteChanged = bEndPointsChanged;
+
+	for (int32 Index = 0; Index < ChangedPoints.Num() && !bRouteChanged; ++Index)
+	{
+		bRouteChanged = RouteSearch.WasNodeReached(ChangedPoints[Index]);
+	}
+
+	if (bRouteChanged)
+	{
+		FindRoutes();
+	}
+}
+
+void FMapGenerationPipeline::UpdatePathNodes(TConstArrayView<int32> Nodes)
+{
+	for (const int32 Node : Nodes)
+	{
+		FGeneratedNode& PathNode = Paths[Node];
+
+		NumStalePathChildNodes += PathNode.NumChildNodes;
+
+		PathNode.FirstChildNode = PathChildNodes.Num();
+		PathNode.ParentNode = INDEX_NONE;
+
+		// Same links as GeneratePaths, where the highest parent is the last one to link a node
+		Triangulation.GetNeighbourPoints(Node, NeighbourPoints);
+
+		for (const int32 Neighbour : NeighbourPoints)
+		{
+			if ((GeneratedPoints[Neighbour].X - PathNode.NodePosition.X) > Settings.SphereRadius / 3.0f)
+			{
+				PathChildNodes.Add(Neighbour);
+			}
+			else if ((PathNode.NodePosition.X - GeneratedPoints[Neighbour].X) > Settings.SphereRadius / 3.0f)
+			{
+				PathNode.ParentNode = Neighbour;
+			}
+		}
+
+		PathNode.NumChildNodes = PathChildNodes.Num() - PathNode.FirstChildNode;
+	}
+
+	if (NumStalePathChildNodes > PathChildNodes.Num() / 2)
+	{
+		CompactPathChildNodes();
+	}
+}
+
+void FMapGenerationPipeline::CompactPathChildNodes()
+{
+	TArray<int32> CompactedChildNodes;
+	CompactedChildNodes.Reserve(PathChildNodes.Num() - NumStalePathChildNodes);
+
+	for (FGeneratedNode& PathNode : Paths)
+	{
+		const int32 FirstChildNode = CompactedChildNodes.Num();
+		CompactedChildNodes.Append(PathChildNodes.GetData() + PathNode.FirstChildNode, PathNode.NumChildNodes);
+		PathNode.FirstChildNode = FirstChildNode;
+	}
+
+	PathChildNodes = MoveTemp(CompactedChildNodes);
+	NumStalePathChildNodes = 0;
+}
+
+FMapGenerationView FMapGenerationPipeline::GetView() const
+{
+	FMapGenerationView View;
+	View.GeneratedPoints = GeneratedPoints;
+	View.Triangles = Triangles;
+	View.HalfEdgeTwins = HalfEdgeTwins;
+	View.Paths = Paths;
+	View.PathChildNodes = PathChildNodes;
+	View.Routes = Routes;
+	View.StartPoint = StartPoint;
+	View.EndPoint = EndPoint;
+	View.StartPointIndex = StartPointIndex;
+	View.EndPointIndex = EndPointIndex;
+
+	if (!bEdgesOutdated)
+	{
+		View.Edges = Edges;
+	}
+
+	return View;
+}
+
+void FMapGenerationPipeline::LoadView(const FMapGenerationView& View)
+{
+	GeneratedPoints = View.GeneratedPoints;
+	Triangles = View.Triangles;
+	HalfEdgeTwins = View.HalfEdgeTwins;
+	Edges = View.Edges;
+	Paths = View.Paths;
+	PathChildNodes = View.PathChildNodes;
+	Routes = View.Routes;
+	StartPoint = View.StartPoint;
+	EndPoint = View.EndPoint;
+	StartPointIndex = View.StartPointIndex;
+	EndPointIndex = View.EndPointIndex;
+
+	bEditableTriangulation = false;
+	bEdgesOutdated = false;
+	NumStalePathChildNodes = 0;
+
+	BuildVertexEdges();
+
+	// The search state of the last route feeds the edits, search again to fill it
+	if (Paths.Num() > 0)
+	{
+		FindRoutes();
+	}
+}
+
+SIZE_T FMapGenerationPipeline::GetAllocatedSize() const
+{
+	const SIZE_T Size = GeneratedPoints.GetAllocatedSize() + Grid.GetAllocatedSize() + Triangles.GetAllocatedSize() + HalfEdgeTwins.GetAllocatedSize() + Edges.GetAllocatedSize()
+		+ VertexEdgeOffsets.GetAllocatedSize() + VertexEdges.GetAllocatedSize();
+
+	return Size + Paths.GetAllocatedSize() + PathChildNodes.GetAllocatedSize() + Routes.GetAllocatedSize();
+}
@@ -0,0 +1,263 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Navigation/MapNavigationGraph.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+FMapNavigationGraph::FMapNavigationGraph()
+{
+	Reset();
+}
+
+void FMapNavigationGraph::Build(const FMapGenerationView& Map)
+{
+	const int32 NumNodes = Map.Paths.Num();
+
+	PositionsX.SetNumUninitialized(NumNodes);
+	PositionsY.SetNumUninitialized(NumNodes);
+	EdgeOffsets.SetNumUninitialized(NumNodes + 1);
+	EdgeTargets.Reset(Map.PathChildNodes.Num());
+	EdgeWeights.Reset(Map.PathChildNodes.Num());
+
+	for (int32 Node = 0; Node < NumNodes; ++Node)
+	{
+		PositionsX[Node] = float(Map.Paths[Node].NodePosition.X);
+		PositionsY[Node] = float(Map.Paths[Node].NodePosition.Y);
+	}
+
+	// The path nodes can point into a child array with stale ranges left by the edits, only the live ones are copied
+	for (int32 Node = 0; Node < NumNodes; ++Node)
+	{
+		EdgeOffsets[Node] = EdgeTargets.Num();
+
+		for (const int32 Child : Map.GetChildNodes(Node))
+		{
+			EdgeTargets.Add(Child);
+			// Measured between the stored positions so the route search heuristic stays consistent with the weights
+			EdgeWeights.Add(float(FVector2D::Distance(GetNodePosition(Node), GetNodePosition(Child))));
+		}
+	}
+
+	EdgeOffsets[NumNodes] = EdgeTargets.Num();
+
+	BuildGrid();
+}
+
+void FMapNavigationGraph::Reset()
+{
+	PositionsX.Reset();
+	PositionsY.Reset();
+	EdgeOffsets.Init(0, 1);
+	EdgeTargets.Reset();
+	EdgeWeights.Reset();
+
+	BuildGrid();
+}
+
+void FMapNavigationGraph::BuildGrid()
+{
+	const int32 NumNodes = GetNumNodes();
+
+	GridCellOffsets.Reset();
+	GridNodes.Reset();
+	GridNumCells = FIntPoint(0);
+
+	if (NumNodes == 0)
+	{
+		return;
+	}
+
+	FVector2D GridMax = GetNodePosition(0);
+	GridMin = GridMax;
+
+	for (int32 Node = 1; Node < NumNodes; ++Node)
+	{
+		const FVector2D Position = GetNodePosition(Node);
+
+		GridMin.X = FMath::Min(GridMin.X, Position.X);
+		GridMin.Y = FMath::Min(GridMin.Y, Position.Y);
+		GridMax.X = FMath::Max(GridMax.X, Position.X);
+		GridMax.Y = FMath::Max(GridMax.Y, Position.Y);
+	}
+
+	const FVector2D Size = GridMax - GridMin;
+	GridCellSize = FMath::Max(FMath::Sqrt(FMath::Max(Size.X, 1.0) * FMath::Max(Size.Y, 1.0) / NumNodes), 1e-3);
+	GridNumCells = FIntPoint(int32(Size.X / GridCellSize) + 1, int32(Size.Y / GridCellSize) + 1);
+
+	// Counting sort of the nodes by cell
+	GridCellOffsets.SetNumZeroed(GridNumCells.X * GridNumCells.Y + 1);
+
+	for (int32 Node = 0; Node < NumNodes; ++Node)
+	{
+		const FIntPoint Cell = GetCell(GetNodePosition(Node));
+		++GridCellOffsets[Cell.Y * GridNumCells.X + Cell.X + 1];
+	}
+
+	for (int32 Cell = 0; Cell < GridNumCells.X * GridNumCells.Y; ++Cell)
+	{
+		GridCellOffsets[Cell + 1] += GridCellOffsets[Cell];
+	}
+
+	TArray<int32> CellCursors = GridCellOffsets;
+	GridNodes.SetNumUninitialized(NumNodes);
+
+	for (int32 Node = 0; Node < NumNodes; ++Node)
+	{
+		const FIntPoint Cell = GetCell(GetNodePosition(Node));
+		GridNodes[CellCursors[Cell.Y * GridNumCells.X + Cell.X]++] = Node;
+	}
+}
+
+FIntPoint FMapNavigationGraph::GetCell(const FVector2D& Position) const
+{
+	const FVector2D Local = (Position - GridMin) / GridCellSize;
+
+	return FIntPoint(FMath::Clamp(FMath::FloorToInt(Local.X), 0, GridNumCells.X - 1), FMath::Clamp(FMath::FloorToInt(Local.Y), 0, GridNumCells.Y - 1));
+}
+
+int32 FMapNavigationGraph::FindNearestNode(const FVector2D& Position) const
+{
+	if (GridNodes.Num() == 0)
+	{
+		return INDEX_NONE;
+	}
+
+	const FIntPoint Center = GetCell(Position);
+	const int32 MaxRing = FMath::Max(GridNumCells.X, GridNumCells.Y);
+
+	int32 NearestNode = INDEX_NONE;
+	double NearestDistanceSquared = TNumericLimits<double>::Max();
+
+	// Rings of cells around the cell of Position, or of its projection on the grid. Every cell past ring R is at least
+	// R cells away from the projection, and Position is at least as far from them as its projection.
+	for (int32 Ring = 0; Ring <= MaxRing; ++Ring)
+	{
+		for (int32 Y = Center.Y - Ring; Y <= Center.Y + Ring; ++Y)
+		{
+			if (Y < 0 || Y >= GridNumCells.Y)
+			{
+				continue;
+			}
+
+			// Only the border of the ring, the inside was visited by the previous rings
+			const bool bBorderRow = FMath::Abs(Y - Center.Y) == Ring;
+			const int32 StepX = bBorderRow ? 1 : 2 * Ring;
+
+			for (int32 X = Center.X - Ring; X <= Center.X + Ring; X += StepX)
+			{
+				if (X < 0 || X >= GridNumCells.X)
+				{
+					continue;
+				}
+
+				const int32 Cell = Y * GridNumCells.X + X;
+
+				for (int32 Index = GridCellOffsets[Cell]; Index < GridCellOffsets[Cell + 1]; ++Index)
+				{
+					const int32 Node = GridNodes[Index];
+					const double DistanceSquared = FVector2D::DistSquared(GetNodePosition(Node), Position);
+
+					if (DistanceSquared < NearestDistanceSquared || (DistanceSquared == NearestDistanceSquared && Node < NearestNode))
+					{
+						NearestDistanceSquared = DistanceSquared;
+						NearestNode = Node;
+					}
+				}
+			}
+		}
+
+		if (NearestNode != INDEX_NONE && NearestDistanceSquared <= FMath::Square(Ring * GridCellSize))
+		{
+			break;
+		}
+	}
+
+	return NearestNode;
+}
+
+SIZE_T FMapNavigationGraph::GetAllocatedSize() const
+{
+	return PositionsX.GetAllocatedSize() + PositionsY.GetAllocatedSize() + EdgeOffsets.GetAllocatedSize() + EdgeTargets.GetAllocatedSize()
+		+ EdgeWeights.GetAllocatedSize() + GridCellOffsets.GetAllocatedSize() + GridNodes.GetAllocatedSize();
+}
+
+static void SerializeArrays(FArchive& Ar, FMapNavigationGraph& Graph)
+{
+	Ar << Graph.PositionsX;
+	Ar << Graph.PositionsY;
+	Ar << Graph.EdgeOffsets;
+	Ar << Graph.EdgeTargets;
+	Ar << Graph.EdgeWeights;
+}
+
+static bool HasValidArrays(const FMapNavigationGraph& Graph)
+{
+	const int32 NumNodes = Graph.PositionsX.Num();
+
+	bool bValid = Graph.PositionsY.Num() == NumNodes && Graph.EdgeWeights.Num() == Graph.EdgeTargets.Num()
+		&& Graph.EdgeOffsets.Num() == NumNodes + 1 && Graph.EdgeOffsets[0] == 0 && Graph.EdgeOffsets[NumNodes] == Graph.EdgeTargets.Num();
+
+	for (int32 Node = 0; bValid && Node < NumNodes; ++Node)
+	{
+		bValid = Graph.EdgeOffsets[Node] <= Graph.EdgeOffsets[Node + 1];
+	}
+
+	for (int32 Edge = 0; bValid && Edge < Graph.EdgeTargets.Num(); ++Edge)
+	{
+		bValid = Graph.EdgeTargets[Edge] >= 0 && Graph.EdgeTargets[Edge] < NumNodes;
+	}
+
+	return bValid;
+}
+
+FArchive& operator<<(FArchive& Ar, FMapNavigationGraph& Graph)
+{
+	// The arrays are written as one sized blob, so a graph of another version or a damaged one is skipped whole and
+	// whatever follows it in the archive still reads
+	int32 Version = FMapNavigationGraph::FormatVersion;
+	TArray<uint8> Data;
+
+	if (!Ar.IsLoading())
+	{
+		FMemoryWriter Writer(Data, Ar.IsPersistent());
+		SerializeArrays(Writer, Graph);
+	}
+
+	Ar << Version;
+
+	// The first version wrote the arrays straight into the archive
+	if (Ar.IsLoading() && Version == 1)
+	{
+		SerializeArrays(Ar, Graph);
+	}
+	else
+	{
+		Ar << Data;
+	}
+
+	if (!Ar.IsLoading())
+	{
+		return Ar;
+	}
+
+	bool bLoaded = Version == 1 && !Ar.IsError();
+
+	if (Version == FMapNavigationGraph::FormatVersion && !Ar.IsError())
+	{
+		FMemoryReader Reader(Data, Ar.IsPersistent());
+		SerializeArrays(Reader, Graph);
+		bLoaded = !Reader.IsError() && Reader.AtEnd();
+	}
+
+	// The grid only depends on the positions, it is built again rather than stored
+	if (bLoaded && HasValidArrays(Graph))
+	{
+		Graph.BuildGrid();
+	}
+	else
+	{
+		Graph.Reset();
+	}
+
+	return Ar;
+}
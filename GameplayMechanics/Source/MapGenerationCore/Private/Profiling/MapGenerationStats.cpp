@@ -0,0 +1,20 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Profiling/MapGenerationStats.h"
+
+void FMapSamplingStats::Accumulate(const FMapSamplingStats& Other)
+{
+	NumTestedCandidates += Other.NumTestedCandidates;
+	NumAcceptedCandidates += Other.NumAcceptedCandidates;
+	NumRejectedCandidates += Other.NumRejectedCandidates;
+	NumRetiredSpawnPoints += Other.NumRetiredSpawnPoints;
+}
+
+void FMapTriangulationStats::Accumulate(const FMapTriangulationStats& Other)
+{
+	NumInsertedPoints += Other.NumInsertedPoints;
+	NumCreatedTriangles += Other.NumCreatedTriangles;
+	NumRemovedTriangles += Other.NumRemovedTriangles;
+	MaxCavityTriangles = FMath::Max(MaxCavityTriangles, Other.MaxCavityTriangles);
+	NumStitchedPoints += Other.NumStitchedPoints;
+}
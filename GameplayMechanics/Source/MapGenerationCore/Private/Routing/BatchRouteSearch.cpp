@@ -0,0 +1,96 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Routing/BatchRouteSearch.h"
+#include "Navigation/MapNavigationGraph.h"
+#include "Async/ParallelFor.h"
+#include <atomic>
+
+void FBatchRouteSearch::FindRoutes(TConstArrayView<FGeneratedNode> Nodes, TConstArrayView<int32> ChildNodes, TConstArrayView<FRouteQuery> Queries, int32 NumThreads, FRouteBatchResult& OutRoutes)
+{
+	Run(Queries, NumThreads, OutRoutes, [Nodes, ChildNodes](FRouteSearch& Search, int32 Start, int32 Goal, TArray<int32>& OutRoute)
+	{
+		Search.FindRoute(Nodes, ChildNodes, Start, Goal, OutRoute);
+	});
+}
+
+void FBatchRouteSearch::FindRoutes(const FMapNavigationGraph& Graph, TConstArrayView<FRouteQuery> Queries, int32 NumThreads, FRouteBatchResult& OutRoutes)
+{
+	Run(Queries, NumThreads, OutRoutes, [&Graph](FRouteSearch& Search, int32 Start, int32 Goal, TArray<int32>& OutRoute)
+	{
+		Search.FindRoute(Graph, Start, Goal, OutRoute);
+	});
+}
+
+template <typename FindRouteType>
+void FBatchRouteSearch::Run(TConstArrayView<FRouteQuery> Queries, int32 NumThreads, FRouteBatchResult& OutRoutes, const FindRouteType& FindRoute)
+{
+	const int32 NumQueries = Queries.Num();
+
+	OutRoutes.RouteOffsets.Reset(NumQueries + 1);
+	OutRoutes.RouteOffsets.SetNumUninitialized(NumQueries + 1);
+	OutRoutes.RouteOffsets[0] = 0;
+	OutRoutes.RouteNodes.Reset();
+
+	if (NumQueries == 0)
+	{
+		return;
+	}
+
+	const int32 NumWorkers = FMath::Clamp(NumThreads > 0 ? NumThreads : FPlatformMisc::NumberOfCoresIncludingHyperthreads(), 1, NumQueries);
+
+	while (Workers.Num() < NumWorkers)
+	{
+		Workers.Add(MakeUnique<FWorker>());
+	}
+
+	QueryWorkers.SetNumUninitialized(NumQueries);
+	QueryRouteStarts.SetNumUninitialized(NumQueries);
+
+	// Route lengths go in the offsets for now, each query writes its own entry
+	int32* RouteLengths = OutRoutes.RouteOffsets.GetData() + 1;
+	std::atomic<int32> NextQuery(0);
+
+	ParallelFor(NumWorkers, [&](int32 WorkerIndex)
+	{
+		FWorker& Worker = *Workers[WorkerIndex];
+		Worker.RouteNodes.Reset();
+
+		for (int32 Query = NextQuery++; Query < NumQueries; Query = NextQuery++)
+		{
+			FindRoute(Worker.Search, Queries[Query].Start, Queries[Query].Goal, Worker.Route);
+
+			QueryWorkers[Query] = WorkerIndex;
+			QueryRouteStarts[Query] = Worker.RouteNodes.Num();
+			RouteLengths[Query] = Worker.Route.Num();
+
+			Worker.RouteNodes.Append(Worker.Route);
+		}
+	});
+
+	for (int32 Query = 0; Query < NumQueries; ++Query)
+	{
+		OutRoutes.RouteOffsets[Query + 1] += OutRoutes.RouteOffsets[Query];
+	}
+
+	OutRoutes.RouteNodes.SetNumUninitialized(OutRoutes.RouteOffsets.Last());
+
+	for (int32 Query = 0; Query < NumQueries; ++Query)
+	{
+		const int32 RouteStart = OutRoutes.RouteOffsets[Query];
+		const int32 RouteLength = OutRoutes.RouteOffsets[Query + 1] - RouteStart;
+
+		FMemory::Memcpy(OutRoutes.RouteNodes.GetData() + RouteStart, Workers[QueryWorkers[Query]]->RouteNodes.GetData() + QueryRouteStarts[Query], RouteLength * sizeof(int32));
+	}
+}
+
+SIZE_T FBatchRouteSearch::GetAllocatedSize() const
+{
+	SIZE_T AllocatedSize = Workers.GetAllocatedSize() + QueryWorkers.GetAllocatedSize() + QueryRouteStarts.GetAllocatedSize();
+
+	for (const TUniquePtr<FWorker>& Worker : Workers)
+	{
+		AllocatedSize += sizeof(FWorker) + Worker->Search.GetAllocatedSize() + Worker->Route.GetAllocatedSize() + Worker->RouteNodes.GetAllocatedSize();
+	}
+
+	return AllocatedSize;
+}
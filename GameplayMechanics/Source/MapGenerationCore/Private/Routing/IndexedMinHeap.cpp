@@ -0,0 +1,119 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Routing/IndexedMinHeap.h"
+
+void FIndexedMinHeap::Init(int32 NumItems)
+{
+	Entries.Reset();
+	ItemPositions.Init(INDEX_NONE, NumItems);
+}
+
+void FIndexedMinHeap::Reset()
+{
+	for (const FEntry& Entry : Entries)
+	{
+		ItemPositions[Entry.Item] = INDEX_NONE;
+	}
+
+	Entries.Reset();
+}
+
+void FIndexedMinHeap::Push(int32 Item, double Key)
+{
+	int32 Position = ItemPositions[Item];
+
+	if (Position == INDEX_NONE)
+	{
+		Position = Entries.Add({ Key, Item });
+		ItemPositions[Item] = Position;
+	}
+	else if (Key < Entries[Position].Key)
+	{
+		Entries[Position].Key = Key;
+	}
+	else
+	{
+		return;
+	}
+
+	SiftUp(Position);
+}
+
+int32 FIndexedMinHeap::Pop()
+{
+	check(!IsEmpty());
+
+	const int32 Item = Entries[0].Item;
+	ItemPositions[Item] = INDEX_NONE;
+
+	const FEntry Last = Entries.Pop(false);
+
+	if (Entries.Num() > 0)
+	{
+		Entries[0] = Last;
+		ItemPositions[Last.Item] = 0;
+		SiftDown(0);
+	}
+
+	return Item;
+}
+
+SIZE_T FIndexedMinHeap::GetAllocatedSize() const
+{
+	return Entries.GetAllocatedSize() + ItemPositions.GetAllocatedSize();
+}
+
+void FIndexedMinHeap::SiftUp(int32 Position)
+{
+	const FEntry Entry = Entries[Position];
+
+	while (Position > 0)
+	{
+		const int32 ParentPosition = (Position - 1) / 2;
+
+		if (Entries[ParentPosition].Key <= Entry.Key)
+		{
+			break;
+		}
+
+		Entries[Position] = Entries[ParentPosition];
+		ItemPositions[Entries[Position].Item] = Position;
+		Position = ParentPosition;
+	}
+
+	Entries[Position] = Entry;
+	ItemPositions[Entry.Item] = Position;
+}
+
+void FIndexedMinHeap::SiftDown(int32 Position)
+{
+	const FEntry Entry = Entries[Position];
+	const int32 NumEntries = Entries.Num();
+
+	while (true)
+	{
+		int32 ChildPosition = 2 * Position + 1;
+
+		if (ChildPosition >= NumEntries)
+		{
+			break;
+		}
+
+		if (ChildPosition + 1 < NumEntries && Entries[ChildPosition + 1].Key < Entries[ChildPosition].Key)
+		{
+			++ChildPosition;
+		}
+
+		if (Entry.Key <= Entries[ChildPosition].Key)
+		{
+			break;
+		}
+
+		Entries[Position] = Entries[ChildPosition];
+		ItemPositions[Entries[Position].Item] = Position;
+		Position = ChildPosition;
+	}
+
+	Entries[Position] = Entry;
+	ItemPositions[Entry.Item] = Position;
+}
@@ -0,0 +1,186 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Routing/RouteSearch.h"
+#include "Navigation/MapNavigationGraph.h"
+
+// Path nodes linked to their children, the cost of a link is its length
+struct FPathNodeGraph
+{
+	TConstArrayView<FGeneratedNode> Nodes;
+	TConstArrayView<int32> ChildNodes;
+
+	int32 Num() const
+	{
+		return Nodes.Num();
+	}
+
+	FVector2D GetPosition(int32 Node) const
+	{
+		return Nodes[Node].NodePosition;
+	}
+
+	template <typename VisitorType>
+	void ForEachChild(int32 Node, VisitorType&& Visit) const
+	{
+		const FGeneratedNode& ParentNode = Nodes[Node];
+
+		for (int32 ChildIndex = 0; ChildIndex < ParentNode.NumChildNodes; ++ChildIndex)
+		{
+			const int32 Child = ChildNodes[ParentNode.FirstChildNode + ChildIndex];
+			Visit(Child, FVector2D::Distance(ParentNode.NodePosition, Nodes[Child].NodePosition));
+		}
+	}
+};
+
+struct FNavigationGraphNodes
+{
+	const FMapNavigationGraph& Graph;
+
+	int32 Num() const
+	{
+		return Graph.GetNumNodes();
+	}
+
+	FVector2D GetPosition(int32 Node) const
+	{
+		return Graph.GetNodePosition(Node);
+	}
+
+	template <typename VisitorType>
+	void ForEachChild(int32 Node, VisitorType&& Visit) const
+	{
+		for (int32 Edge = Graph.EdgeOffsets[Node]; Edge < Graph.EdgeOffsets[Node + 1]; ++Edge)
+		{
+			Visit(Graph.EdgeTargets[Edge], double(Graph.EdgeWeights[Edge]));
+		}
+	}
+};
+
+bool FRouteSearch::FindRoute(TConstArrayView<FGeneratedNode> Nodes, TConstArrayView<int32> ChildNodes, int32 Start, int32 Goal, TArray<int32>& OutRoute)
+{
+	return Search(FPathNodeGraph{ Nodes, ChildNodes }, Start, Goal, OutRoute);
+}
+
+bool FRouteSearch::FindRoute(const FMapNavigationGraph& Graph, int32 Start, int32 Goal, TArray<int32>& OutRoute)
+{
+	return Search(FNavigationGraphNodes{ Graph }, Start, Goal, OutRoute);
+}
+
+template <typename GraphType>
+bool FRouteSearch::Search(const GraphType& Graph, int32 Start, int32 Goal, TArray<int32>& OutRoute)
+{
+	OutRoute.Reset();
+
+	// The previous search is only cleared now, see WasNodeReached
+	ResetTouchedNodes();
+
+	NumExpandedNodes = 0;
+	MaxOpenNodes = 0;
+
+	const int32 NumNodes = Graph.Num();
+
+	if (Start < 0 || Start >= NumNodes || Goal < 0 || Goal >= NumNodes)
+	{
+		return false;
+	}
+
+	Prepare(NumNodes);
+
+	const FVector2D GoalPosition = Graph.GetPosition(Goal);
+
+	CostFromStart[Start] = 0.0;
+	TouchedNodes.Add(Start);
+	OpenNodes.Push(Start, FVector2D::Distance(Graph.GetPosition(Start), GoalPosition));
+	MaxOpenNodes = 1;
+
+	bool bFoundGoal = false;
+
+	while (!OpenNodes.IsEmpty())
+	{
+		const int32 Current = OpenNodes.Pop();
+
+		if (Current == Goal)
+		{
+			bFoundGoal = true;
+			break;
+		}
+
+		// The distance heuristic is consistent with the edge lengths, so a closed node never has to be reopened
+		ClosedNodes[Current] = true;
+		++NumExpandedNodes;
+
+		const double CurrentCost = CostFromStart[Current];
+
+		Graph.ForEachChild(Current, [this, &Graph, &GoalPosition, Current, CurrentCost](int32 Child, double LinkCost)
+		{
+			if (ClosedNodes[Child])
+			{
+				return;
+			}
+
+			const double Cost = CurrentCost + LinkCost;
+
+			if (Cost < CostFromStart[Child])
+			{
+				if (CostFromStart[Child] == TNumericLimits<double>::Max())
+				{
+					TouchedNodes.Add(Child);
+				}
+
+				CostFromStart[Child] = Cost;
+				Parents[Child] = Current;
+				OpenNodes.Push(Child, Cost + FVector2D::Distance(Graph.GetPosition(Child), GoalPosition));
+			}
+		});
+
+		MaxOpenNodes = FMath::Max(MaxOpenNodes, OpenNodes.Num());
+	}
+
+	if (bFoundGoal)
+	{
+		// Size the route first so it is filled backward in a single allocation
+		int32 NumRouteNodes = 0;
+		for (int32 Node = Goal; Node != INDEX_NONE; Node = Parents[Node])
+		{
+			++NumRouteNodes;
+		}
+
+		OutRoute.SetNumUninitialized(NumRouteNodes);
+
+		for (int32 Node = Goal; Node != INDEX_NONE; Node = Parents[Node])
+		{
+			OutRoute[--NumRouteNodes] = Node;
+		}
+	}
+
+	return bFoundGoal;
+}
+
+SIZE_T FRouteSearch::GetAllocatedSize() const
+{
+	return CostFromStart.GetAllocatedSize() + Parents.GetAllocatedSize() + ClosedNodes.GetAllocatedSize() + TouchedNodes.GetAllocatedSize() + OpenNodes.GetAllocatedSize();
+}
+
+void FRouteSearch::Prepare(int32 NumNodes)
+{
+	if (CostFromStart.Num() != NumNodes)
+	{
+		CostFromStart.Init(TNumericLimits<double>::Max(), NumNodes);
+		Parents.Init(INDEX_NONE, NumNodes);
+		ClosedNodes.Init(false, NumNodes);
+		OpenNodes.Init(NumNodes);
+	}
+}
+
+void FRouteSearch::ResetTouchedNodes()
+{
+	for (const int32 Node : TouchedNodes)
+	{
+		CostFromStart[Node] = TNumericLimits<double>::Max();
+		Parents[Node] = INDEX_NONE;
+		ClosedNodes[Node] = false;
+	}
+
+	TouchedNodes.Reset();
+	OpenNodes.Reset();
+}
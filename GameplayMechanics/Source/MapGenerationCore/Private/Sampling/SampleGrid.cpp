@@ -0,0 +1,168 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Sampling/SampleGrid.h"
+#include <cmath>
+
+#define SAMPLE_GRID_USE_SSE (PLATFORM_ENABLE_VECTORINTRINSICS && PLATFORM_CPU_X86_FAMILY)
+
+#if SAMPLE_GRID_USE_SSE
+#include <emmintrin.h>
+#endif
+
+// Far enough that its distance to any position in the region is above any radius, while its square still fits a float
+static const FVector2D EmptyCellPosition = FVector2D(-1.0e15);
+
+void FSampleGrid::Init(float InExtend, float InCellSize)
+{
+	Extend = InExtend;
+	CellSize = InCellSize;
+	InvCellSize = 1.0 / InCellSize;
+	// Sized from the cell of the last position inside the region, with the same double arithmetic as GetCellIndex,
+	// as dividing in float can round it one cell short
+	NumCells = int32(std::nextafter(double(InExtend), 0.0) * InvCellSize) + 1;
+
+	// Rows start on a cache line
+	Stride = Align(NumCells + 2 * Padding, PLATFORM_CACHE_LINE_SIZE / sizeof(FVector2D));
+
+	Cells.Reset();
+	Cells.Init(EmptyCellPosition, Stride * (NumCells + 2 * Padding));
+
+	int32 NumOffsets = 0;
+	for (int32 X = -Padding; X <= Padding; ++X)
+	{
+		for (int32 Y = -Padding; Y <= Padding; ++Y)
+		{
+			if (FMath::Abs(X) < Padding || FMath::Abs(Y) < Padding)
+			{
+				NeighbourOffsets[NumOffsets++] = X * Stride + Y;
+			}
+		}
+	}
+
+	check(NumOffsets == NumNeighbours);
+}
+
+int32 FSampleGrid::FindFirstFreePosition(const FVector2D* Positions, int32 NumPositions, float Radius) const
+{
+#if SAMPLE_GRID_USE_SSE
+	static_assert(BatchSize == 4, "The SSE path tests two pairs of positions");
+
+	const float RadiusSquared = Radius * Radius;
+	const __m128 RadiusSquaredVector = _mm_set1_ps(RadiusSquared);
+
+	for (int32 FirstPosition = 0; FirstPosition < NumPositions; FirstPosition += BatchSize)
+	{
+		const int32 NumInBatch = FMath::Min(BatchSize, NumPositions - FirstPosition);
+
+		int32 CellIndices[BatchSize];
+		double X[BatchSize];
+		double Y[BatchSize];
+		uint32 InsideMask = 0;
+
+		for (int32 Lane = 0; Lane < BatchSize; ++Lane)
+		{
+			const FVector2D& Position = Positions[FirstPosition + FMath::Min(Lane, NumInBatch - 1)];
+			const bool bInside = Lane < NumInBatch && IsInside(Position);
+
+			CellIndices[Lane] = bInside ? GetCellIndex(Position) : INDEX_NONE;
+			X[Lane] = Position.X;
+			Y[Lane] = Position.Y;
+			InsideMask |= bInside ? 1u << Lane : 0u;
+		}
+
+		if (InsideMask == 0)
+		{
+			continue;
+		}
+
+		// Masked out lanes read the same cells as an inside lane, never cells another sampling thread may be writing
+		const int32 InsideCellIndex = CellIndices[FMath::CountTrailingZeros(InsideMask)];
+
+		for (int32 Lane = 0; Lane < BatchSize; ++Lane)
+		{
+			CellIndices[Lane] = CellIndices[Lane] == INDEX_NONE ? InsideCellIndex : CellIndices[Lane];
+		}
+
+		const __m128d X01 = _mm_loadu_pd(X);
+		const __m128d X23 = _mm_loadu_pd(X + 2);
+		const __m128d Y01 = _mm_loadu_pd(Y);
+		const __m128d Y23 = _mm_loadu_pd(Y + 2);
+
+		const FVector2D* Cells0 = Cells.GetData() + CellIndices[0];
+		const FVector2D* Cells1 = Cells.GetData() + CellIndices[1];
+		const FVector2D* Cells2 = Cells.GetData() + CellIndices[2];
+		const FVector2D* Cells3 = Cells.GetData() + CellIndices[3];
+
+		uint32 CloseMask = 0;
+
+		for (const int32 Offset : NeighbourOffsets)
+		{
+			// Each cell is an (X, Y) pair, transpose two of them into an X pair and an Y pair
+			const __m128d Cell0 = _mm_loadu_pd(&Cells0[Offset].X);
+			const __m128d Cell1 = _mm_loadu_pd(&Cells1[Offset].X);
+			const __m128d Cell2 = _mm_loadu_pd(&Cells2[Offset].X);
+			const __m128d Cell3 = _mm_loadu_pd(&Cells3[Offset].X);
+
+			const __m128d DeltaX01 = _mm_sub_pd(X01, _mm_unpacklo_pd(Cell0, Cell1));
+			const __m128d DeltaY01 = _mm_sub_pd(Y01, _mm_unpackhi_pd(Cell0, Cell1));
+			const __m128d DeltaX23 = _mm_sub_pd(X23, _mm_unpacklo_pd(Cell2, Cell3));
+			const __m128d DeltaY23 = _mm_sub_pd(Y23, _mm_unpackhi_pd(Cell2, Cell3));
+
+			const __m128d DistanceSquared01 = _mm_add_pd(_mm_mul_pd(DeltaX01, DeltaX01), _mm_mul_pd(DeltaY01, DeltaY01));
+			const __m128d DistanceSquared23 = _mm_add_pd(_mm_mul_pd(DeltaX23, DeltaX23), _mm_mul_pd(DeltaY23, DeltaY23));
+
+			// Compared as float like the scalar test
+			const __m128 DistanceSquared = _mm_movelh_ps(_mm_cvtpd_ps(DistanceSquared01), _mm_cvtpd_ps(DistanceSquared23));
+			CloseMask |= uint32(_mm_movemask_ps(_mm_cmplt_ps(DistanceSquared, RadiusSquaredVector)));
+
+			if ((InsideMask & ~CloseMask) == 0)
+			{
+				break;
+			}
+		}
+
+		const uint32 FreeMask = InsideMask & ~CloseMask;
+
+		if (FreeMask != 0)
+		{
+			return FirstPosition + int32(FMath::CountTrailingZeros(FreeMask));
+		}
+	}
+#else
+	for (int32 Index = 0; Index < NumPositions; ++Index)
+	{
+		if (IsInside(Positions[Index]) && !HasSampleCloserThan(Positions[Index], Radius))
+		{
+			return Index;
+		}
+	}
+#endif
+
+	return INDEX_NONE;
+}
+
+void FSampleGrid::GatherSamples(const FIntPoint& MinCell, const FIntPoint& EndCell, TArray<FVector2D>& OutPositions) const
+{
+	const int32 StartX = FMath::Max(MinCell.X, 0);
+	const int32 StartY = FMath::Max(MinCell.Y, 0);
+	const int32 EndX = FMath::Min(EndCell.X, NumCells);
+	const int32 EndY = FMath::Min(EndCell.Y, NumCells);
+
+	for (int32 X = StartX; X < EndX; ++X)
+	{
+		const FVector2D* Row = Cells.GetData() + (X + Padding) * Stride + Padding;
+
+		for (int32 Y = StartY; Y < EndY; ++Y)
+		{
+			if (Row[Y].X != EmptyCellPosition.X)
+			{
+				OutPositions.Add(Row[Y]);
+			}
+		}
+	}
+}
+
+SIZE_T FSampleGrid::GetAllocatedSize() const
+{
+	return Cells.GetAllocatedSize();
+}
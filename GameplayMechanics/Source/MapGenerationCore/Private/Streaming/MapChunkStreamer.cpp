@@ -0,0 +1,303 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Streaming/MapChunkStreamer.h"
+#include "Algo/Sort.h"
+
+SIZE_T FMapChunk::GetAllocatedSize() const
+{
+	return sizeof(FMapChunk) + Points.GetAllocatedSize() + Triangles.GetAllocatedSize();
+}
+
+FMapChunkStreamer::FMapChunkStreamer(const FMapGenerationSettings& InSettings, int32 InLoadRadius, SIZE_T InMemoryBudget) :
+	Settings(InSettings),
+	LoadRadius(FMath::Max(0, InLoadRadius)),
+	MemoryBudget(InMemoryBudget)
+{
+	const float CellSize = Settings.SphereRadius / FMath::Sqrt(2.0f);
+
+	// Chunk borders fall on the sampling cells, and chunks of the same phase stay further apart than a candidate can reach
+	ChunkCells = FMath::Max(4, FMath::RoundToInt(Settings.GridExtend / CellSize));
+	ChunkSize = double(ChunkCells) * CellSize;
+
+	Sampler.Settings = Settings;
+	Sampler.Settings.GridExtend = float(3.0 * ChunkSize);
+}
+
+bool FMapChunkStreamer::Update(const FVector2D& FocusPoint)
+{
+	const FIntPoint NewFocusChunk = GetChunkCoord(FocusPoint);
+
+	if (LoadedChunks.Num() > 0 && NewFocusChunk == FocusChunk)
+	{
+		return false;
+	}
+
+	++UpdateCount;
+
+	FocusChunk = NewFocusChunk;
+	LoadedChunks.Reset();
+
+	for (int32 X = -LoadRadius; X <= LoadRadius; ++X)
+	{
+		for (int32 Y = -LoadRadius; Y <= LoadRadius; ++Y)
+		{
+			const FIntPoint Coord = FocusChunk + FIntPoint(X, Y);
+			GetChunk(Coord);
+			LoadedChunks.Add(Coord);
+		}
+	}
+
+	Evict();
+	return true;
+}
+
+const FMapChunk& FMapChunkStreamer::GetChunk(const FIntPoint& Coord)
+{
+	FMapChunk& Chunk = GetSampledChunk(Coord);
+	Triangulate(Chunk);
+	return Chunk;
+}
+
+const FMapChunk* FMapChunkStreamer::FindChunk(const FIntPoint& Coord) const
+{
+	const TUniquePtr<FMapChunk>* Chunk = Chunks.Find(Coord);
+	return Chunk ? Chunk->Get() : nullptr;
+}
+
+FIntPoint FMapChunkStreamer::GetChunkCoord(const FVector2D& Position) const
+{
+	return FIntPoint(FMath::FloorToInt(Position.X / ChunkSize), FMath::FloorToInt(Position.Y / ChunkSize));
+}
+
+FMapChunk& FMapChunkStreamer::GetSampledChunk(const FIntPoint& Coord)
+{
+	if (TUniquePtr<FMapChunk>* FoundChunk = Chunks.Find(Coord))
+	{
+		Touch(**FoundChunk);
+		return **FoundChunk;
+	}
+
+	// Only the neighbours of earlier phases, whatever is already in memory, so the samples do not depend on the order chunks are
+	// generated in. Their own neighbours are sampled first, which ends after three phases.
+	const int32 Phase = GetPhase(Coord);
+	const FMapChunk* EarlierNeighbours[8];
+	int32 NumEarlierNeighbours = 0;
+
+	for (int32 X = -1; X <= 1; ++X)
+	{
+		for (int32 Y = -1; Y <= 1; ++Y)
+		{
+			const FIntPoint NeighbourCoord = Coord + FIntPoint(X, Y);
+
+			if (GetPhase(NeighbourCoord) < Phase)
+			{
+				EarlierNeighbours[NumEarlierNeighbours++] = &GetSampledChunk(NeighbourCoord);
+			}
+		}
+	}
+
+	// The sampler covers the 3x3 chunks with the chunk in the middle
+	const FVector2D LocalOrigin = FVector2D(Coord - FIntPoint(1)) * ChunkSize;
+
+	LocalPoints.Reset();
+
+	for (int32 Index = 0; Index < NumEarlierNeighbours; ++Index)
+	{
+		for (int32 Point = 0; Point < EarlierNeighbours[Index]->NumOwnPoints; ++Point)
+		{
+			LocalPoints.Add(EarlierNeighbours[Index]->Points[Point] - LocalOrigin);
+		}
+	}
+
+	TUniquePtr<FMapChunk> NewChunk = MakeUnique<FMapChunk>();
+	NewChunk->Coord = Coord;
+
+	FRandomStream ChunkRandom(int32(HashCombine(GetTypeHash(Settings.Seed), GetTypeHash(Coord))));
+	Sampler.PoisonDiskSamplingCells(ChunkRandom, LocalPoints, FIntPoint(ChunkCells), FIntPoint(2 * ChunkCells), NewChunk->Points);
+
+	for (FVector2D& Point : NewChunk->Points)
+	{
+		Point += LocalOrigin;
+	}
+
+	NewChunk->NumOwnPoints = NewChunk->Points.Num();
+	Touch(*NewChunk);
+	AllocatedSize += NewChunk->GetAllocatedSize();
+
+	FMapChunk& Chunk = *NewChunk;
+	Chunks.Add(Coord, MoveTemp(NewChunk));
+	return Chunk;
+}
+
+void FMapChunkStreamer::Triangulate(FMapChunk& Chunk)
+{
+	if (Chunk.bTriangulated)
+	{
+		return;
+	}
+
+	// The samples of a sparse map leave holes wider than a chunk, whose triangles need more rings of neighbours. Past the last
+	// ring the triangles that are still not certified are left out rather than risk overlapping those of the neighbours.
+	for (int32 NumRings = 1; NumRings <= MaxTriangulationRings; ++NumRings)
+	{
+		if (TriangulateOwnedTriangles(Chunk, NumRings))
+		{
+			break;
+		}
+	}
+
+	AllocatedSize -= Chunk.GetAllocatedSize();
+
+	const int32 NumOwnPoints = Chunk.NumOwnPoints;
+
+	LocalToChunkPoints.Reset();
+	LocalToChunkPoints.SetNumUninitialized(LocalPoints.Num());
+
+	for (int32 Point = 0; Point < LocalPoints.Num(); ++Point)
+	{
+		LocalToChunkPoints[Point] = Point < NumOwnPoints ? Point : INDEX_NONE;
+	}
+
+	Chunk.Triangles.Reset(OwnedTriangles.Num());
+
+	for (const FGeneratedTriangle& Triangle : OwnedTriangles)
+	{
+		int32 ChunkCorners[3];
+
+		for (int32 Corner = 0; Corner < 3; ++Corner)
+		{
+			int32& ChunkPoint = LocalToChunkPoints[Triangle[Corner]];
+
+			if (ChunkPoint == INDEX_NONE)
+			{
+				ChunkPoint = Chunk.Points.Add(LocalPoints[Triangle[Corner]]);
+			}
+
+			ChunkCorners[Corner] = ChunkPoint;
+		}
+
+		Chunk.Triangles.Add(FGeneratedTriangle(ChunkCorners[0], ChunkCorners[1], ChunkCorners[2]));
+	}
+
+	Chunk.bTriangulated = true;
+	AllocatedSize += Chunk.GetAllocatedSize();
+}
+
+bool FMapChunkStreamer::TriangulateOwnedTriangles(const FMapChunk& Chunk, int32 NumRings)
+{
+	// Sampling the neighbours reuses the scratch arrays, so it is done before filling them
+	Neighbours.Reset();
+
+	for (int32 X = -NumRings; X <= NumRings; ++X)
+	{
+		for (int32 Y = -NumRings; Y <= NumRings; ++Y)
+		{
+			if (X != 0 || Y != 0)
+			{
+				Neighbours.Add(&GetSampledChunk(Chunk.Coord + FIntPoint(X, Y)));
+			}
+		}
+	}
+
+	const int32 NumOwnPoints = Chunk.NumOwnPoints;
+
+	LocalPoints.Reset();
+	LocalPoints.Append(Chunk.Points.GetData(), NumOwnPoints);
+
+	for (const FMapChunk* Neighbour : Neighbours)
+	{
+		LocalPoints.Append(Neighbour->Points.GetData(), Neighbour->NumOwnPoints);
+	}
+
+	// A triangle of the whole map has no sample in its circumcircle, so it is also a triangle of these samples. Conversely a triangle
+	// of these samples whose circumcircle stays within the chunks they come from has no other sample of the map in it either.
+	Triangulation.Triangulate(LocalPoints);
+	Triangulation.GetTriangles(LocalTriangles, LocalHalfEdgeTwins);
+
+	const FVector2D BlockMin = FVector2D(Chunk.Coord - FIntPoint(NumRings)) * ChunkSize;
+	const FVector2D BlockMax = FVector2D(Chunk.Coord + FIntPoint(NumRings + 1)) * ChunkSize;
+
+	OwnedTriangles.Reset();
+	bool bCertified = true;
+
+	// Every triangle around a sample of the chunk is checked, not only the owned ones: once the whole fan of a sample is closed
+	// and certified it is its fan in the whole map, so no owned triangle can be missing either
+	for (int32 TriangleIndex = 0; TriangleIndex < LocalTriangles.Num(); ++TriangleIndex)
+	{
+		const FGeneratedTriangle& Triangle = LocalTriangles[TriangleIndex];
+
+		if (Triangle[0] >= NumOwnPoints && Triangle[1] >= NumOwnPoints && Triangle[2] >= NumOwnPoints)
+		{
+			continue;
+		}
+
+		FVector2D Center;
+		double Radius;
+		Triangle.ComputeCircumCircle(LocalPoints, Center, Radius);
+
+		// The margin covers the rounding of the circle and of the samples on the chunk borders, and NaN circles fail the comparisons
+		const double Reach = Radius + 1.0e-9 * (FMath::Abs(Center.X) + FMath::Abs(Center.Y)) + 1.0e-6 * Radius;
+
+		const bool bInsideBlock = Center.X - Reach > BlockMin.X && Center.X + Reach < BlockMax.X && Center.Y - Reach > BlockMin.Y && Center.Y + Reach < BlockMax.Y;
+		const bool bOnHull = LocalHalfEdgeTwins[3 * TriangleIndex] == INDEX_NONE || LocalHalfEdgeTwins[3 * TriangleIndex + 1] == INDEX_NONE
+			|| LocalHalfEdgeTwins[3 * TriangleIndex + 2] == INDEX_NONE;
+
+		if (!bInsideBlock || bOnHull)
+		{
+			bCertified = false;
+			continue;
+		}
+
+		int32 LowestCorner = 0;
+
+		for (int32 Corner = 1; Corner < 3; ++Corner)
+		{
+			const FVector2D& Point = LocalPoints[Triangle[Corner]];
+			const FVector2D& Lowest = LocalPoints[Triangle[LowestCorner]];
+
+			if (Point.X < Lowest.X || (Point.X == Lowest.X && Point.Y < Lowest.Y))
+			{
+				LowestCorner = Corner;
+			}
+		}
+
+		if (Triangle[LowestCorner] < NumOwnPoints)
+		{
+			OwnedTriangles.Add(Triangle);
+		}
+	}
+
+	return bCertified;
+}
+
+void FMapChunkStreamer::Evict()
+{
+	if (AllocatedSize <= MemoryBudget)
+	{
+		return;
+	}
+
+	// Least recently used first, leaving the chunks of this update
+	TArray<TPair<uint64, FIntPoint>> EvictableChunks;
+
+	for (const TPair<FIntPoint, TUniquePtr<FMapChunk>>& Chunk : Chunks)
+	{
+		if (Chunk.Value->LastUsed < UpdateCount)
+		{
+			EvictableChunks.Add(TPair<uint64, FIntPoint>(Chunk.Value->LastUsed, Chunk.Key));
+		}
+	}
+
+	Algo::Sort(EvictableChunks, [](const TPair<uint64, FIntPoint>& A, const TPair<uint64, FIntPoint>& B)
+	{
+		return A.Key < B.Key;
+	});
+
+	for (int32 Index = 0; Index < EvictableChunks.Num() && AllocatedSize > MemoryBudget; ++Index)
+	{
+		const FIntPoint& Coord = EvictableChunks[Index].Value;
+
+		AllocatedSize -= FindChunk(Coord)->GetAllocatedSize();
+		Chunks.Remove(Coord);
+	}
+}
@@ -0,0 +1,15 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Structs/GeneratedEdge.h"
+
+
+FGeneratedEdge::FGeneratedEdge() :
+	StartVertex(INDEX_NONE), EndVertex(INDEX_NONE)
+{
+}
+
+FGeneratedEdge::FGeneratedEdge(int32 v1, int32 v2):
+	StartVertex(v1), EndVertex(v2)
+{
+}
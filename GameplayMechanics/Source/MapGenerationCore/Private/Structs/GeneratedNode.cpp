@@ -5,7 +5,7 @@
 
 FGeneratedNode::FGeneratedNode()
 {
-	ParentNode = nullptr;
+	ParentNode = INDEX_NONE;
 }
 
 
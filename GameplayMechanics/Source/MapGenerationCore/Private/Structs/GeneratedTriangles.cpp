@@ -0,0 +1,47 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "Structs/GeneratedTriangles.h"
+#include "Triangulation/GeometricPredicates.h"
+
+FGeneratedTriangle::FGeneratedTriangle() :
+	Vertex1(INDEX_NONE), Vertex2(INDEX_NONE), Vertex3(INDEX_NONE)
+{
+}
+
+FGeneratedTriangle::FGeneratedTriangle(int32 v1, int32 v2, int32 v3) :
+	Vertex1(v1), Vertex2(v2), Vertex3(v3)
+{
+};
+
+bool FGeneratedTriangle::CircumCircleContains(const TArray<FVector2D>& Points, const FVector2D &Vertex) const
+{
+	const FVector2D& Position1 = Points[Vertex1];
+	const FVector2D& Position2 = Points[Vertex2];
+	const FVector2D& Position3 = Points[Vertex3];
+
+	const double Determinant = FGeometricPredicates::InCircle(Position1, Position2, Position3, Vertex);
+
+	// The determinant changes sign with the winding, points on the circle count as inside
+	return FGeometricPredicates::Orient(Position1, Position2, Position3) < 0.0 ? Determinant <= 0.0 : Determinant >= 0.0;
+}
+
+void FGeneratedTriangle::ComputeCircumCircle(TConstArrayView<FVector2D> Points, FVector2D& OutCenter, double& OutRadius) const
+{
+	int32 Corners[3] = { Vertex1, Vertex2, Vertex3 };
+
+	if (Corners[0] > Corners[1]) Swap(Corners[0], Corners[1]);
+	if (Corners[1] > Corners[2]) Swap(Corners[1], Corners[2]);
+	if (Corners[0] > Corners[1]) Swap(Corners[0], Corners[1]);
+
+	const FVector2D& A = Points[Corners[0]];
+	const FVector2D B = Points[Corners[1]] - A;
+	const FVector2D C = Points[Corners[2]] - A;
+
+	const double Denominator = 2.0 * (B.X * C.Y - B.Y * C.X);
+	const double BSquared = B.X * B.X + B.Y * B.Y;
+	const double CSquared = C.X * C.X + C.Y * C.Y;
+
+	const FVector2D Offset((C.Y * BSquared - B.Y * CSquared) / Denominator, (B.X * CSquared - C.X * BSquared) / Denominator);
+
+	OutCenter = A + Offset;
+	OutRadius = FMath::Sqrt(Offset.X * Offset.X + Offset.Y * Offset.Y);
+}
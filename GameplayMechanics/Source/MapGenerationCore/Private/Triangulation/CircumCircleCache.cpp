@@ -0,0 +1,113 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Triangulation/CircumCircleCache.h"
+
+#define CIRCUMCIRCLE_CACHE_USE_SSE (PLATFORM_ENABLE_VECTORINTRINSICS && PLATFORM_CPU_X86_FAMILY)
+
+#if CIRCUMCIRCLE_CACHE_USE_SSE
+#include <emmintrin.h>
+#endif
+
+// Half an ulp of 1.0, the relative rounding error of one double operation
+static constexpr double Epsilon = 1.1102230246251565e-16;
+
+void FCircumCircleCache::Add(const FVector2D& A, const FVector2D& B, const FVector2D& C)
+{
+	const FVector2D AB = B - A;
+	const FVector2D AC = C - A;
+
+	const double Cross = AB.X * AC.Y - AB.Y * AC.X;
+	const double ABSquared = AB.X * AB.X + AB.Y * AB.Y;
+	const double ACSquared = AC.X * AC.X + AC.Y * AC.Y;
+
+	const FVector2D Offset((AC.Y * ABSquared - AB.Y * ACSquared) / (2.0 * Cross), (AB.X * ACSquared - AC.X * ABSquared) / (2.0 * Cross));
+	const FVector2D Center = A + Offset;
+	const double Radius = FMath::Sqrt(Offset.X * Offset.X + Offset.Y * Offset.Y);
+
+	// The centre error grows with the edges over the area, the flatter the triangle the worse. The last term covers the rounding
+	// of the centre and of the query distances, at most as large as the coordinates.
+	const double MaxEdgeSquared = FMath::Max(ABSquared, ACSquared);
+	const double MaxEdge = FMath::Sqrt(MaxEdgeSquared);
+	const double Slack = 32.0 * Epsilon * (MaxEdge + Radius) * MaxEdgeSquared / FMath::Abs(Cross)
+		+ 8.0 * Epsilon * (FMath::Abs(Center.X) + FMath::Abs(Center.Y) + Radius);
+
+	const double Inflated = (Radius + Slack) * (Radius + Slack) * (1.0 + 16.0 * Epsilon);
+
+	if (FMath::IsFinite(Center.X) && FMath::IsFinite(Center.Y) && FMath::IsFinite(Inflated))
+	{
+		CenterX.Add(Center.X);
+		CenterY.Add(Center.Y);
+		InflatedRadiusSquared.Add(Inflated);
+	}
+	else
+	{
+		// Degenerate triangle, its circle contains everything
+		CenterX.Add(0.0);
+		CenterY.Add(0.0);
+		InflatedRadiusSquared.Add(TNumericLimits<double>::Max());
+	}
+}
+
+void FCircumCircleCache::RemoveFlagged(TConstArrayView<bool> Flags)
+{
+	int32 NumKept = 0;
+
+	for (int32 Index = 0; Index < CenterX.Num(); ++Index)
+	{
+		if (!Flags[Index])
+		{
+			CenterX[NumKept] = CenterX[Index];
+			CenterY[NumKept] = CenterY[Index];
+			InflatedRadiusSquared[NumKept] = InflatedRadiusSquared[Index];
+			++NumKept;
+		}
+	}
+
+	CenterX.SetNum(NumKept, false);
+	CenterY.SetNum(NumKept, false);
+	InflatedRadiusSquared.SetNum(NumKept, false);
+}
+
+void FCircumCircleCache::FindContaining(const FVector2D& Point, TArray<int32>& OutIndices) const
+{
+	const int32 NumCircles = CenterX.Num();
+	int32 FirstCircle = 0;
+
+#if CIRCUMCIRCLE_CACHE_USE_SSE
+	static_assert(BatchSize == 4, "The SSE path tests two pairs of circles");
+
+	const __m128d PointX = _mm_set1_pd(Point.X);
+	const __m128d PointY = _mm_set1_pd(Point.Y);
+
+	for (; FirstCircle + BatchSize <= NumCircles; FirstCircle += BatchSize)
+	{
+		const __m128d DeltaX01 = _mm_sub_pd(PointX, _mm_loadu_pd(&CenterX[FirstCircle]));
+		const __m128d DeltaX23 = _mm_sub_pd(PointX, _mm_loadu_pd(&CenterX[FirstCircle + 2]));
+		const __m128d DeltaY01 = _mm_sub_pd(PointY, _mm_loadu_pd(&CenterY[FirstCircle]));
+		const __m128d DeltaY23 = _mm_sub_pd(PointY, _mm_loadu_pd(&CenterY[FirstCircle + 2]));
+
+		const __m128d DistanceSquared01 = _mm_add_pd(_mm_mul_pd(DeltaX01, DeltaX01), _mm_mul_pd(DeltaY01, DeltaY01));
+		const __m128d DistanceSquared23 = _mm_add_pd(_mm_mul_pd(DeltaX23, DeltaX23), _mm_mul_pd(DeltaY23, DeltaY23));
+
+		uint32 InsideMask = uint32(_mm_movemask_pd(_mm_cmple_pd(DistanceSquared01, _mm_loadu_pd(&InflatedRadiusSquared[FirstCircle]))))
+			| uint32(_mm_movemask_pd(_mm_cmple_pd(DistanceSquared23, _mm_loadu_pd(&InflatedRadiusSquared[FirstCircle + 2])))) << 2;
+
+		while (InsideMask != 0)
+		{
+			OutIndices.Add(FirstCircle + int32(FMath::CountTrailingZeros(InsideMask)));
+			InsideMask &= InsideMask - 1;
+		}
+	}
+#endif
+
+	for (int32 Index = FirstCircle; Index < NumCircles; ++Index)
+	{
+		const double DeltaX = Point.X - CenterX[Index];
+		const double DeltaY = Point.Y - CenterY[Index];
+
+		if (DeltaX * DeltaX + DeltaY * DeltaY <= InflatedRadiusSquared[Index])
+		{
+			OutIndices.Add(Index);
+		}
+	}
+}
@@ -0,0 +1,875 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Triangulation/DelaunayTriangulation.h"
+#include "Triangulation/GeometricPredicates.h"
+#include "Algo/Unique.h"
+
+// Position of (X, Y) along a Hilbert curve covering a 2^16 x 2^16 grid
+static uint32 HilbertIndex(uint32 X, uint32 Y)
+{
+	uint32 Index = 0;
+
+	for (uint32 Side = 1u << 15; Side > 0; Side >>= 1)
+	{
+		const uint32 RegionX = (X & Side) > 0 ? 1 : 0;
+		const uint32 RegionY = (Y & Side) > 0 ? 1 : 0;
+		Index += Side * Side * ((3 * RegionX) ^ RegionY);
+
+		// Rotate the quadrant so the curve stays continuous
+		if (RegionY == 0)
+		{
+			if (RegionX == 1)
+			{
+				X = Side - 1 - X;
+				Y = Side - 1 - Y;
+			}
+
+			Swap(X, Y);
+		}
+	}
+
+	return Index;
+}
+
+void FDelaunayTriangulation::ComputeSuperTriangle(TConstArrayView<FVector2D> Points, FVector2D& OutLeftVertex, FVector2D& OutRightVertex, FVector2D& OutUpVertex)
+{
+	FVector2D MinVertices = Points.Num() > 0 ? Points[0] : FVector2D(0.0f);
+	FVector2D MaxVertices = MinVertices;
+
+	for (int Index = 1; Index < Points.Num(); ++Index)
+	{
+		const FVector2D& Vertice = Points[Index];
+
+		if (Vertice.X > MaxVertices.X) MaxVertices.X = Vertice.X;
+		if (Vertice.Y > MaxVertices.Y) MaxVertices.Y = Vertice.Y;
+		if (Vertice.X < MinVertices.X) MinVertices.X = Vertice.X;
+		if (Vertice.Y < MinVertices.Y) MinVertices.Y = Vertice.Y;
+	}
+
+	const float Dx = MaxVertices.X - MinVertices.X;
+	const float Dy = MaxVertices.Y - MinVertices.Y;
+
+	const float DeltaMax = FMath::Max(1.0f, FMath::Max(Dx, Dy));
+
+	const float MidX = (MaxVertices.X + MinVertices.X) / 2.0f;
+	const float MidY = (MaxVertices.Y + MinVertices.Y) / 2.0f;
+
+	OutLeftVertex = FVector2D(MidX - 50.0f * DeltaMax, MidY - DeltaMax);
+	OutRightVertex = FVector2D(MidX + 50.0f * DeltaMax, MidY - DeltaMax);
+	OutUpVertex = FVector2D(MidX, MidY + 50.0f * DeltaMax);
+}
+
+void FDelaunayTriangulation::Triangulate(TConstArrayView<FVector2D> Points)
+{
+	FVector2D LeftVertex, RightVertex, UpVertex;
+	ComputeSuperTriangle(Points, LeftVertex, RightVertex, UpVertex);
+
+	Triangulate(Points, LeftVertex, RightVertex, UpVertex);
+}
+
+void FDelaunayTriangulation::Triangulate(TConstArrayView<FVector2D> Points, const FVector2D& LeftVertex, const FVector2D& RightVertex, const FVector2D& UpVertex)
+{
+	NumPoints = Points.Num();
+
+	Vertices.Reset(NumSuperVertices + NumPoints);
+	Vertices.Add(LeftVertex);
+	Vertices.Add(RightVertex);
+	Vertices.Add(UpVertex);
+	Vertices.Append(Points.GetData(), NumPoints);
+
+	// Every insertion removes k triangles and adds k + 2
+	const int32 MaxTriangles = 2 * (NumPoints + NumSuperVertices);
+	TriangleVertices.Reset(3 * MaxTriangles);
+	TriangleNeighbours.Reset(3 * MaxTriangles);
+	TriangleStamps.Reset(MaxTriangles);
+
+	TriangleVertices.Append({ 0, 1, 2 });
+	TriangleNeighbours.Append({ INDEX_NONE, INDEX_NONE, INDEX_NONE });
+	TriangleStamps.Add(0);
+
+	CurrentStamp = 0;
+	LastTriangle = 0;
+
+	Stats = FMapTriangulationStats();
+
+	// Duplicated points are left out of the triangulation and keep INDEX_NONE
+	VertexTriangles.Init(INDEX_NONE, NumSuperVertices + NumPoints);
+
+	bExporting = false;
+	ExportedIndices.Reset();
+	ExportedSlots.Reset();
+	FreeExportedIndices.Reset();
+	ChangedTriangles.Reset();
+
+	if (NumPoints == 0)
+	{
+		return;
+	}
+
+	// Insert in Hilbert curve order so consecutive points are close and the walk from the last triangle stays short
+	FVector2D MinBounds = Points[0];
+	FVector2D MaxBounds = Points[0];
+
+	for (const FVector2D& Point : Points)
+	{
+		MinBounds.X = FMath::Min(MinBounds.X, Point.X);
+		MinBounds.Y = FMath::Min(MinBounds.Y, Point.Y);
+		MaxBounds.X = FMath::Max(MaxBounds.X, Point.X);
+		MaxBounds.Y = FMath::Max(MaxBounds.Y, Point.Y);
+	}
+
+	const double Extend = FMath::Max(MaxBounds.X - MinBounds.X, MaxBounds.Y - MinBounds.Y);
+	const double Scale = Extend > 0.0 ? 65535.0 / Extend : 0.0;
+
+	TArray<uint64> InsertionOrder;
+	InsertionOrder.SetNumUninitialized(NumPoints);
+
+	for (int32 Index = 0; Index < NumPoints; ++Index)
+	{
+		const uint32 GridX = (uint32)((Points[Index].X - MinBounds.X) * Scale);
+		const uint32 GridY = (uint32)((Points[Index].Y - MinBounds.Y) * Scale);
+		InsertionOrder[Index] = ((uint64)HilbertIndex(GridX, GridY) << 32) | (uint32)Index;
+	}
+
+	InsertionOrder.Sort();
+
+	for (const uint64 Key : InsertionOrder)
+	{
+		InsertVertex(NumSuperVertices + (int32)(Key & 0xffffffff));
+	}
+}
+
+int32 FDelaunayTriangulation::NumTriangles() const
+{
+	int32 Count = 0;
+
+	for (int32 Triangle = 0; Triangle < TriangleStamps.Num(); ++Triangle)
+	{
+		if (!IsSuperTriangle(Triangle))
+		{
+			++Count;
+		}
+	}
+
+	return Count;
+}
+
+void FDelaunayTriangulation::GetTriangles(TArray<FGeneratedTriangle>& OutTriangles, TArray<int32>& OutHalfEdgeTwins) const
+{
+	// Compact the triangles away from the super triangle
+	TArray<int32> TriangleRemap;
+	TriangleRemap.SetNumUninitialized(TriangleStamps.Num());
+
+	int32 NumOutTriangles = 0;
+	for (int32 Triangle = 0; Triangle < TriangleStamps.Num(); ++Triangle)
+	{
+		TriangleRemap[Triangle] = IsSuperTriangle(Triangle) ? INDEX_NONE : NumOutTriangles++;
+	}
+
+	OutTriangles.Reset(NumOutTriangles);
+	OutHalfEdgeTwins.Reset(3 * NumOutTriangles);
+
+	for (int32 Triangle = 0; Triangle < TriangleStamps.Num(); ++Triangle)
+	{
+		if (TriangleRemap[Triangle] == INDEX_NONE)
+		{
+			continue;
+		}
+
+		const int32* Corners = &TriangleVertices[3 * Triangle];
+		OutTriangles.Add(FGeneratedTriangle(Corners[0] - NumSuperVertices, Corners[1] - NumSuperVertices, Corners[2] - NumSuperVertices));
+
+		for (int32 Edge = 0; Edge < 3; ++Edge)
+		{
+			const int32 Neighbour = TriangleNeighbours[3 * Triangle + Edge];
+
+			if (Neighbour == INDEX_NONE || TriangleRemap[Neighbour] == INDEX_NONE)
+			{
+				OutHalfEdgeTwins.Add(INDEX_NONE);
+			}
+			else
+			{
+				const int32 NeighbourEdge = FindNeighbourEdge(Neighbour, Corners[(Edge + 1) % 3], Corners[Edge]);
+				OutHalfEdgeTwins.Add(3 * TriangleRemap[Neighbour] + NeighbourEdge);
+			}
+		}
+	}
+}
+
+int32 FDelaunayTriangulation::AddPoint(const FVector2D& Position)
+{
+	if (!IsInsideSuperTriangle(Position))
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 VertexIndex = Vertices.Add(Position);
+	VertexTriangles.Add(INDEX_NONE);
+	++NumPoints;
+
+	if (!InsertVertex(VertexIndex))
+	{
+		Vertices.Pop(false);
+		VertexTriangles.Pop(false);
+		--NumPoints;
+		return INDEX_NONE;
+	}
+
+	return VertexIndex - NumSuperVertices;
+}
+
+void FDelaunayTriangulation::RemovePoint(int32 Point)
+{
+	check(Point >= 0 && Point < NumPoints);
+
+	const int32 VertexIndex = NumSuperVertices + Point;
+	if (VertexTriangles[VertexIndex] != INDEX_NONE)
+	{
+		DetachVertex(VertexIndex);
+	}
+
+	// The last vertex takes the freed index in every triangle around it
+	const int32 LastVertex = Vertices.Num() - 1;
+	if (VertexIndex != LastVertex && VertexTriangles[LastVertex] != INDEX_NONE)
+	{
+		const int32 FirstTriangle = VertexTriangles[LastVertex];
+		int32 Triangle = FirstTriangle;
+
+		do
+		{
+			const int32 Corner = FindCorner(Triangle, LastVertex);
+			TriangleVertices[3 * Triangle + Corner] = VertexIndex;
+			MarkChanged(Triangle);
+
+			Triangle = TriangleNeighbours[3 * Triangle + (Corner + 2) % 3];
+		}
+		while (Triangle != FirstTriangle);
+	}
+
+	Vertices[VertexIndex] = Vertices[LastVertex];
+	VertexTriangles[VertexIndex] = VertexTriangles[LastVertex];
+
+	Vertices.Pop(false);
+	VertexTriangles.Pop(false);
+	--NumPoints;
+}
+
+bool FDelaunayTriangulation::MovePoint(int32 Point, const FVector2D& NewPosition)
+{
+	check(Point >= 0 && Point < NumPoints);
+
+	const int32 VertexIndex = NumSuperVertices + Point;
+	const FVector2D OldPosition = Vertices[VertexIndex];
+
+	if (OldPosition == NewPosition)
+	{
+		return true;
+	}
+
+	if (!IsInsideSuperTriangle(NewPosition))
+	{
+		return false;
+	}
+
+	const bool bWasInserted = VertexTriangles[VertexIndex] != INDEX_NONE;
+	if (bWasInserted)
+	{
+		DetachVertex(VertexIndex);
+	}
+
+	Vertices[VertexIndex] = NewPosition;
+
+	if (!InsertVertex(VertexIndex))
+	{
+		Vertices[VertexIndex] = OldPosition;
+		if (bWasInserted)
+		{
+			verify(InsertVertex(VertexIndex));
+		}
+		return false;
+	}
+
+	return true;
+}
+
+void FDelaunayTriangulation::GetNeighbourPoints(int32 Point, TArray<int32>& OutNeighbours) const
+{
+	OutNeighbours.Reset();
+
+	const int32 VertexIndex = NumSuperVertices + Point;
+	const int32 FirstTriangle = VertexTriangles[VertexIndex];
+
+	if (FirstTriangle == INDEX_NONE)
+	{
+		return;
+	}
+
+	int32 Triangle = FirstTriangle;
+
+	do
+	{
+		const int32 Corner = FindCorner(Triangle, VertexIndex);
+		const int32 Other = TriangleVertices[3 * Triangle + (Corner + 1) % 3];
+		const int32 Neighbour = TriangleNeighbours[3 * Triangle + Corner];
+
+		// The edge is exported when either triangle beside it is
+		if (Other >= NumSuperVertices && (!IsSuperTriangle(Triangle) || (Neighbour != INDEX_NONE && !IsSuperTriangle(Neighbour))))
+		{
+			OutNeighbours.Add(Other - NumSuperVertices);
+		}
+
+		Triangle = TriangleNeighbours[3 * Triangle + (Corner + 2) % 3];
+	}
+	while (Triangle != FirstTriangle);
+
+	OutNeighbours.Sort();
+}
+
+void FDelaunayTriangulation::ExportTriangles(TArray<FGeneratedTriangle>& OutTriangles, TArray<int32>& OutHalfEdgeTwins)
+{
+	GetTriangles(OutTriangles, OutHalfEdgeTwins);
+
+	// GetTriangles keeps the slot order
+	ExportedIndices.SetNumUninitialized(TriangleStamps.Num());
+	ExportedSlots.Reset(OutTriangles.Num());
+
+	for (int32 Triangle = 0; Triangle < TriangleStamps.Num(); ++Triangle)
+	{
+		ExportedIndices[Triangle] = IsSuperTriangle(Triangle) ? INDEX_NONE : ExportedSlots.Add(Triangle);
+	}
+
+	FreeExportedIndices.Reset();
+	ChangedTriangles.Reset();
+	bExporting = true;
+}
+
+void FDelaunayTriangulation::UpdateExportedTriangles(TArray<FGeneratedTriangle>& InOutTriangles, TArray<int32>& InOutHalfEdgeTwins, TArray<int32>& OutChangedPoints)
+{
+	check(bExporting && InOutTriangles.Num() == ExportedSlots.Num());
+
+	OutChangedPoints.Reset();
+	DirtySlots.Reset();
+
+	CurrentStamp += 2;
+	const uint32 DirtyStamp = CurrentStamp;
+
+	for (const int32 Triangle : ChangedTriangles)
+	{
+		// Slots freed after being changed are gone
+		if (Triangle < TriangleStamps.Num() && TriangleStamps[Triangle] != DirtyStamp)
+		{
+			TriangleStamps[Triangle] = DirtyStamp;
+			DirtySlots.Add(Triangle);
+		}
+	}
+
+	ChangedTriangles.Reset();
+
+	// Rewrite the changed triangles, giving them an exported index or taking it back when they now touch the super triangle
+	for (const int32 Triangle : DirtySlots)
+	{
+		const int32* Corners = &TriangleVertices[3 * Triangle];
+
+		for (int32 Corner = 0; Corner < 3; ++Corner)
+		{
+			if (Corners[Corner] >= NumSuperVertices)
+			{
+				OutChangedPoints.Add(Corners[Corner] - NumSuperVertices);
+			}
+		}
+
+		int32& ExportedIndex = ExportedIndices[Triangle];
+
+		if (IsSuperTriangle(Triangle))
+		{
+			if (ExportedIndex != INDEX_NONE)
+			{
+				FreeExportedIndices.Add(ExportedIndex);
+				ExportedSlots[ExportedIndex] = INDEX_NONE;
+				ExportedIndex = INDEX_NONE;
+			}
+			continue;
+		}
+
+		if (ExportedIndex == INDEX_NONE)
+		{
+			if (FreeExportedIndices.Num() > 0)
+			{
+				ExportedIndex = FreeExportedIndices.Pop(false);
+			}
+			else
+			{
+				ExportedIndex = InOutTriangles.AddDefaulted();
+				InOutHalfEdgeTwins.AddUninitialized(3);
+				ExportedSlots.Add(INDEX_NONE);
+			}
+
+			ExportedSlots[ExportedIndex] = Triangle;
+		}
+
+		InOutTriangles[ExportedIndex] = FGeneratedTriangle(Corners[0] - NumSuperVertices, Corners[1] - NumSuperVertices, Corners[2] - NumSuperVertices);
+	}
+
+	// Fill the holes left by removed triangles with the last ones, which then need their twins written again
+	FreeExportedIndices.Sort();
+
+	int32 NumExported = InOutTriangles.Num();
+	for (int32 Index = 0; Index < FreeExportedIndices.Num(); ++Index)
+	{
+		while (FreeExportedIndices.Num() > Index && FreeExportedIndices.Last() == NumExported - 1)
+		{
+			FreeExportedIndices.Pop(false);
+			--NumExported;
+		}
+
+		if (Index == FreeExportedIndices.Num())
+		{
+			break;
+		}
+
+		const int32 Hole = FreeExportedIndices[Index];
+		const int32 MovedSlot = ExportedSlots[--NumExported];
+
+		InOutTriangles[Hole] = InOutTriangles[NumExported];
+		ExportedSlots[Hole] = MovedSlot;
+		ExportedIndices[MovedSlot] = Hole;
+
+		if (TriangleStamps[MovedSlot] != DirtyStamp)
+		{
+			TriangleStamps[MovedSlot] = DirtyStamp;
+			DirtySlots.Add(MovedSlot);
+		}
+	}
+
+	FreeExportedIndices.Reset();
+	InOutTriangles.SetNum(NumExported, false);
+	InOutHalfEdgeTwins.SetNum(3 * NumExported, false);
+	ExportedSlots.SetNum(NumExported, false);
+
+	// Write both sides of every twin, the unchanged neighbours of a changed triangle get their side from it
+	for (const int32 Triangle : DirtySlots)
+	{
+		const int32 ExportedIndex = ExportedIndices[Triangle];
+
+		if (ExportedIndex == INDEX_NONE)
+		{
+			continue;
+		}
+
+		for (int32 Edge = 0; Edge < 3; ++Edge)
+		{
+			const int32 Neighbour = TriangleNeighbours[3 * Triangle + Edge];
+			const int32 NeighbourIndex = Neighbour != INDEX_NONE ? ExportedIndices[Neighbour] : INDEX_NONE;
+
+			if (NeighbourIndex == INDEX_NONE)
+			{
+				InOutHalfEdgeTwins[3 * ExportedIndex + Edge] = INDEX_NONE;
+			}
+			else
+			{
+				const int32 NeighbourEdge = FindNeighbourEdge(Neighbour, TriangleVertices[3 * Triangle + (Edge + 1) % 3], TriangleVertices[3 * Triangle + Edge]);
+				InOutHalfEdgeTwins[3 * ExportedIndex + Edge] = 3 * NeighbourIndex + NeighbourEdge;
+				InOutHalfEdgeTwins[3 * NeighbourIndex + NeighbourEdge] = 3 * ExportedIndex + Edge;
+			}
+		}
+	}
+
+	DirtySlots.Reset();
+
+	OutChangedPoints.Sort();
+	OutChangedPoints.SetNum(Algo::Unique(OutChangedPoints), false);
+}
+
+bool FDelaunayTriangulation::IsSuperTriangle(int32 Triangle) const
+{
+	return TriangleVertices[3 * Triangle] < NumSuperVertices || TriangleVertices[3 * Triangle + 1] < NumSuperVertices || TriangleVertices[3 * Triangle + 2] < NumSuperVertices;
+}
+
+bool FDelaunayTriangulation::IsInsideSuperTriangle(const FVector2D& Position) const
+{
+	return FGeometricPredicates::Orient(Vertices[0], Vertices[1], Position) > 0.0
+		&& FGeometricPredicates::Orient(Vertices[1], Vertices[2], Position) > 0.0
+		&& FGeometricPredicates::Orient(Vertices[2], Vertices[0], Position) > 0.0;
+}
+
+bool FDelaunayTriangulation::InsertVertex(int32 VertexIndex)
+{
+	const FVector2D& Position = Vertices[VertexIndex];
+
+	const int32 StartTriangle = LocateTriangle(Position);
+
+	for (int32 Corner = 0; Corner < 3; ++Corner)
+	{
+		if (Vertices[TriangleVertices[3 * StartTriangle + Corner]] == Position)
+		{
+			// Duplicated point, it is already part of the triangulation
+			return false;
+		}
+	}
+
+	// Bad triangles get the even stamp, triangles already checked and kept get the odd one
+	CurrentStamp += 2;
+	const uint32 BadStamp = CurrentStamp;
+	const uint32 GoodStamp = CurrentStamp + 1;
+
+	CavityTriangles.Reset();
+	CavityStack.Reset();
+	CavityEdges.Reset();
+
+	// The containing triangle is always removed, then the cavity grows through the neighbours whose circumcircle holds the point
+	TriangleStamps[StartTriangle] = BadStamp;
+	CavityStack.Add(StartTriangle);
+
+	while (CavityStack.Num() > 0)
+	{
+		const int32 Triangle = CavityStack.Pop(false);
+		CavityTriangles.Add(Triangle);
+
+		for (int32 Edge = 0; Edge < 3; ++Edge)
+		{
+			const int32 Neighbour = TriangleNeighbours[3 * Triangle + Edge];
+
+			if (Neighbour != INDEX_NONE)
+			{
+				if (TriangleStamps[Neighbour] == BadStamp)
+				{
+					continue;
+				}
+
+				if (TriangleStamps[Neighbour] != GoodStamp)
+				{
+					const int32* Corners = &TriangleVertices[3 * Neighbour];
+
+					if (FGeometricPredicates::InCircle(Vertices[Corners[0]], Vertices[Corners[1]], Vertices[Corners[2]], Position) > 0.0)
+					{
+						TriangleStamps[Neighbour] = BadStamp;
+						CavityStack.Add(Neighbour);
+						continue;
+					}
+
+					TriangleStamps[Neighbour] = GoodStamp;
+				}
+			}
+
+			CavityEdges.Add({ TriangleVertices[3 * Triangle + Edge], TriangleVertices[3 * Triangle + (Edge + 1) % 3], Neighbour });
+		}
+	}
+
+	// Fan the cavity boundary around the new vertex, reusing the removed slots first
+	for (int32 Index = 0; Index < CavityEdges.Num(); ++Index)
+	{
+		const FCavityEdge& CavityEdge = CavityEdges[Index];
+
+		int32 Triangle;
+		if (Index < CavityTriangles.Num())
+		{
+			Triangle = CavityTriangles[Index];
+		}
+		else
+		{
+			Triangle = AddTriangleSlot();
+		}
+
+		TriangleVertices[3 * Triangle] = CavityEdge.StartVertex;
+		TriangleVertices[3 * Triangle + 1] = CavityEdge.EndVertex;
+		TriangleVertices[3 * Triangle + 2] = VertexIndex;
+		TriangleNeighbours[3 * Triangle] = CavityEdge.OuterTriangle;
+		TriangleStamps[Triangle] = 0;
+
+		if (CavityEdge.OuterTriangle != INDEX_NONE)
+		{
+			const int32 OuterEdge = FindNeighbourEdge(CavityEdge.OuterTriangle, CavityEdge.EndVertex, CavityEdge.StartVertex);
+			TriangleNeighbours[3 * CavityEdge.OuterTriangle + OuterEdge] = Triangle;
+			MarkChanged(CavityEdge.OuterTriangle);
+		}
+
+		VertexTriangles[CavityEdge.StartVertex] = Triangle;
+		MarkChanged(Triangle);
+	}
+
+	// Each new triangle (A, B, P) shares (B, P) with the new triangle that starts at B
+	for (int32 Index = 0; Index < CavityEdges.Num(); ++Index)
+	{
+		const int32 Triangle = Index < CavityTriangles.Num() ? CavityTriangles[Index] : TriangleStamps.Num() - (CavityEdges.Num() - Index);
+		const int32 NextTriangle = VertexTriangles[TriangleVertices[3 * Triangle + 1]];
+
+		TriangleNeighbours[3 * Triangle + 1] = NextTriangle;
+		TriangleNeighbours[3 * NextTriangle + 2] = Triangle;
+	}
+
+	LastTriangle = VertexTriangles[CavityEdges.Last().StartVertex];
+	VertexTriangles[VertexIndex] = LastTriangle;
+
+	++Stats.NumInsertedPoints;
+	Stats.NumCreatedTriangles += CavityEdges.Num();
+	Stats.NumRemovedTriangles += CavityTriangles.Num();
+	Stats.MaxCavityTriangles = FMath::Max(Stats.MaxCavityTriangles, CavityTriangles.Num());
+
+	return true;
+}
+
+int32 FDelaunayTriangulation::LocateTriangle(const FVector2D& Position) const
+{
+	int32 Triangle = LastTriangle;
+	int32 FirstEdge = 0;
+
+	// Visibility walk: cross any edge that has the point on its outer side
+	while (true)
+	{
+		int32 NextTriangle = INDEX_NONE;
+
+		for (int32 Step = 0; Step < 3; ++Step)
+		{
+			const int32 Edge = (FirstEdge + Step) % 3;
+			const FVector2D& Start = Vertices[TriangleVertices[3 * Triangle + Edge]];
+			const FVector2D& End = Vertices[TriangleVertices[3 * Triangle + (Edge + 1) % 3]];
+
+			if (FGeometricPredicates::Orient(Start, End, Position) < 0.0 && TriangleNeighbours[3 * Triangle + Edge] != INDEX_NONE)
+			{
+				NextTriangle = TriangleNeighbours[3 * Triangle + Edge];
+				break;
+			}
+		}
+
+		if (NextTriangle == INDEX_NONE)
+		{
+			return Triangle;
+		}
+
+		Triangle = NextTriangle;
+		// Rotating the first tested edge keeps the walk from cycling on nearly degenerate configurations
+		FirstEdge = (FirstEdge + 1) % 3;
+	}
+}
+
+int32 FDelaunayTriangulation::FindNeighbourEdge(int32 Triangle, int32 StartVertex, int32 EndVertex) const
+{
+	for (int32 Edge = 0; Edge < 3; ++Edge)
+	{
+		if (TriangleVertices[3 * Triangle + Edge] == StartVertex && TriangleVertices[3 * Triangle + (Edge + 1) % 3] == EndVertex)
+		{
+			return Edge;
+		}
+	}
+
+	check(false);
+	return INDEX_NONE;
+}
+
+void FDelaunayTriangulation::DetachVertex(int32 VertexIndex)
+{
+	StarTriangles.Reset();
+	PolygonVertices.Reset();
+	PolygonOuterTriangles.Reset();
+	PolygonOuterEdges.Reset();
+
+	// Walk counter clockwise around the vertex, the far edges of its triangles form the polygon to fill
+	const int32 FirstTriangle = VertexTriangles[VertexIndex];
+	int32 Triangle = FirstTriangle;
+
+	do
+	{
+		const int32 Corner = FindCorner(Triangle, VertexIndex);
+		const int32 StartVertex = TriangleVertices[3 * Triangle + (Corner + 1) % 3];
+		const int32 EndVertex = TriangleVertices[3 * Triangle + (Corner + 2) % 3];
+		const int32 OuterTriangle = TriangleNeighbours[3 * Triangle + (Corner + 1) % 3];
+
+		StarTriangles.Add(Triangle);
+		PolygonVertices.Add(StartVertex);
+		PolygonOuterTriangles.Add(OuterTriangle);
+		PolygonOuterEdges.Add(OuterTriangle != INDEX_NONE ? FindNeighbourEdge(OuterTriangle, EndVertex, StartVertex) : INDEX_NONE);
+
+		Triangle = TriangleNeighbours[3 * Triangle + (Corner + 2) % 3];
+	}
+	while (Triangle != FirstTriangle);
+
+	// Cut convex ears whose circumcircle holds no other polygon vertex. They are the Delaunay triangles of the polygon vertices,
+	// and no point outside the star can lie in their circles, so the result is the triangulation without the vertex.
+	int32 NumFilled = 0;
+
+	while (PolygonVertices.Num() > 3)
+	{
+		const int32 NumPolygonVertices = PolygonVertices.Num();
+		int32 Ear = INDEX_NONE;
+
+		for (int32 Index = 0; Index < NumPolygonVertices && Ear == INDEX_NONE; ++Index)
+		{
+			const FVector2D& Previous = Vertices[PolygonVertices[(Index + NumPolygonVertices - 1) % NumPolygonVertices]];
+			const FVector2D& Current = Vertices[PolygonVertices[Index]];
+			const FVector2D& Next = Vertices[PolygonVertices[(Index + 1) % NumPolygonVertices]];
+
+			if (FGeometricPredicates::Orient(Previous, Current, Next) <= 0.0)
+			{
+				continue;
+			}
+
+			Ear = Index;
+
+			for (int32 Offset = 2; Offset < NumPolygonVertices - 1; ++Offset)
+			{
+				if (FGeometricPredicates::InCircle(Previous, Current, Next, Vertices[PolygonVertices[(Index + Offset) % NumPolygonVertices]]) > 0.0)
+				{
+					Ear = INDEX_NONE;
+					break;
+				}
+			}
+		}
+
+		check(Ear != INDEX_NONE);
+
+		const int32 Previous = (Ear + NumPolygonVertices - 1) % NumPolygonVertices;
+		const int32 Next = (Ear + 1) % NumPolygonVertices;
+		const int32 NewTriangle = StarTriangles[NumFilled++];
+
+		TriangleVertices[3 * NewTriangle] = PolygonVertices[Previous];
+		TriangleVertices[3 * NewTriangle + 1] = PolygonVertices[Ear];
+		TriangleVertices[3 * NewTriangle + 2] = PolygonVertices[Next];
+		TriangleStamps[NewTriangle] = 0;
+
+		LinkTriangles(NewTriangle, 0, PolygonOuterTriangles[Previous], PolygonOuterEdges[Previous]);
+		LinkTriangles(NewTriangle, 1, PolygonOuterTriangles[Ear], PolygonOuterEdges[Ear]);
+		TriangleNeighbours[3 * NewTriangle + 2] = INDEX_NONE;
+		MarkChanged(NewTriangle);
+
+		// The cut diagonal replaces the two ear edges, with the ear across it
+		PolygonOuterTriangles[Previous] = NewTriangle;
+		PolygonOuterEdges[Previous] = 2;
+
+		PolygonVertices.RemoveAt(Ear, 1, false);
+		PolygonOuterTriangles.RemoveAt(Ear, 1, false);
+		PolygonOuterEdges.RemoveAt(Ear, 1, false);
+
+		VertexTriangles[TriangleVertices[3 * NewTriangle]] = NewTriangle;
+		VertexTriangles[TriangleVertices[3 * NewTriangle + 1]] = NewTriangle;
+		VertexTriangles[TriangleVertices[3 * NewTriangle + 2]] = NewTriangle;
+	}
+
+	const int32 LastFilled = StarTriangles[NumFilled++];
+
+	for (int32 Corner = 0; Corner < 3; ++Corner)
+	{
+		TriangleVertices[3 * LastFilled + Corner] = PolygonVertices[Corner];
+		LinkTriangles(LastFilled, Corner, PolygonOuterTriangles[Corner], PolygonOuterEdges[Corner]);
+		VertexTriangles[PolygonVertices[Corner]] = LastFilled;
+	}
+
+	TriangleStamps[LastFilled] = 0;
+	MarkChanged(LastFilled);
+	LastTriangle = LastFilled;
+	VertexTriangles[VertexIndex] = INDEX_NONE;
+
+	// The star held two more triangles than the polygon, free the highest slot first so the other one is not moved
+	const int32 FreedSlot0 = StarTriangles[NumFilled];
+	const int32 FreedSlot1 = StarTriangles[NumFilled + 1];
+
+	RemoveTriangleSlot(FMath::Max(FreedSlot0, FreedSlot1));
+	RemoveTriangleSlot(FMath::Min(FreedSlot0, FreedSlot1));
+}
+
+int32 FDelaunayTriangulation::AddTriangleSlot()
+{
+	TriangleVertices.AddUninitialized(3);
+	TriangleNeighbours.AddUninitialized(3);
+
+	if (bExporting)
+	{
+		ExportedIndices.Add(INDEX_NONE);
+	}
+
+	return TriangleStamps.Add(0);
+}
+
+void FDelaunayTriangulation::RemoveTriangleSlot(int32 Triangle)
+{
+	if (bExporting && ExportedIndices[Triangle] != INDEX_NONE)
+	{
+		FreeExportedIndices.Add(ExportedIndices[Triangle]);
+		ExportedSlots[ExportedIndices[Triangle]] = INDEX_NONE;
+	}
+
+	const int32 LastSlot = TriangleStamps.Num() - 1;
+
+	if (Triangle != LastSlot)
+	{
+		for (int32 Corner = 0; Corner < 3; ++Corner)
+		{
+			const int32 Vertex = TriangleVertices[3 * LastSlot + Corner];
+			const int32 Neighbour = TriangleNeighbours[3 * LastSlot + Corner];
+
+			TriangleVertices[3 * Triangle + Corner] = Vertex;
+			TriangleNeighbours[3 * Triangle + Corner] = Neighbour;
+
+			if (Neighbour != INDEX_NONE)
+			{
+				const int32 NeighbourEdge = FindNeighbourEdge(Neighbour, TriangleVertices[3 * LastSlot + (Corner + 1) % 3], Vertex);
+				TriangleNeighbours[3 * Neighbour + NeighbourEdge] = Triangle;
+			}
+
+			if (VertexTriangles[Vertex] == LastSlot)
+			{
+				VertexTriangles[Vertex] = Triangle;
+			}
+		}
+
+		TriangleStamps[Triangle] = TriangleStamps[LastSlot];
+
+		if (LastTriangle == LastSlot)
+		{
+			LastTriangle = Triangle;
+		}
+
+		if (bExporting)
+		{
+			ExportedIndices[Triangle] = ExportedIndices[LastSlot];
+
+			if (ExportedIndices[Triangle] != INDEX_NONE)
+			{
+				ExportedSlots[ExportedIndices[Triangle]] = Triangle;
+			}
+		}
+
+		MarkChanged(Triangle);
+	}
+
+	TriangleVertices.SetNum(3 * LastSlot, false);
+	TriangleNeighbours.SetNum(3 * LastSlot, false);
+	TriangleStamps.Pop(false);
+
+	if (bExporting)
+	{
+		ExportedIndices.Pop(false);
+	}
+}
+
+void FDelaunayTriangulation::LinkTriangles(int32 Triangle, int32 Edge, int32 OtherTriangle, int32 OtherEdge)
+{
+	TriangleNeighbours[3 * Triangle + Edge] = OtherTriangle;
+
+	if (OtherTriangle != INDEX_NONE)
+	{
+		TriangleNeighbours[3 * OtherTriangle + OtherEdge] = Triangle;
+		MarkChanged(OtherTriangle);
+	}
+}
+
+void FDelaunayTriangulation::MarkChanged(int32 Triangle)
+{
+	if (bExporting)
+	{
+		ChangedTriangles.Add(Triangle);
+	}
+}
+
+int32 FDelaunayTriangulation::FindCorner(int32 Triangle, int32 Vertex) const
+{
+	for (int32 Corner = 0; Corner < 3; ++Corner)
+	{
+		if (TriangleVertices[3 * Triangle + Corner] == Vertex)
+		{
+			return Corner;
+		}
+	}
+
+	check(false);
+	return INDEX_NONE;
+}
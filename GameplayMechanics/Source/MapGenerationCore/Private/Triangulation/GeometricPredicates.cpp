@@ -0,0 +1,197 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Triangulation/GeometricPredicates.h"
+
+// 2^27 + 1, splits a double into two halves whose products are exact
+static constexpr double Splitter = 134217729.0;
+
+// Exact sum of doubles as non overlapping components of increasing magnitude, without zero components
+using FExpansion = TArray<double, TInlineAllocator<32>>;
+
+// Sum and rounding error of A + B, when |A| >= |B|
+static FORCEINLINE void FastTwoSum(double A, double B, double& OutSum, double& OutError)
+{
+	OutSum = A + B;
+	OutError = B - (OutSum - A);
+}
+
+static FORCEINLINE void TwoSum(double A, double B, double& OutSum, double& OutError)
+{
+	OutSum = A + B;
+	const double BVirtual = OutSum - A;
+	const double AVirtual = OutSum - BVirtual;
+	OutError = (A - AVirtual) + (B - BVirtual);
+}
+
+static FORCEINLINE void Split(double A, double& OutHigh, double& OutLow)
+{
+	const double Scaled = Splitter * A;
+	OutHigh = Scaled - (Scaled - A);
+	OutLow = A - OutHigh;
+}
+
+static FORCEINLINE void TwoProduct(double A, double B, double& OutProduct, double& OutError)
+{
+	OutProduct = A * B;
+
+	double AHigh, ALow, BHigh, BLow;
+	Split(A, AHigh, ALow);
+	Split(B, BHigh, BLow);
+
+	const double Error1 = OutProduct - AHigh * BHigh;
+	const double Error2 = Error1 - ALow * BHigh;
+	const double Error3 = Error2 - AHigh * BLow;
+	OutError = ALow * BLow - Error3;
+}
+
+// A - B as an expansion
+static FExpansion MakeDifference(double A, double B)
+{
+	const double Difference = A - B;
+	const double BVirtual = A - Difference;
+	const double AVirtual = Difference + BVirtual;
+	const double Error = (A - AVirtual) + (BVirtual - B);
+
+	FExpansion Result;
+	if (Error != 0.0)
+	{
+		Result.Add(Error);
+	}
+	if (Difference != 0.0)
+	{
+		Result.Add(Difference);
+	}
+	return Result;
+}
+
+static FExpansion Negate(FExpansion Expansion)
+{
+	for (double& Component : Expansion)
+	{
+		Component = -Component;
+	}
+	return Expansion;
+}
+
+static FExpansion Add(const FExpansion& E, const FExpansion& F)
+{
+	FExpansion Result = E;
+
+	// Grow the expansion by one component of F at a time
+	for (const double Component : F)
+	{
+		FExpansion Grown;
+		double Sum = Component;
+
+		for (const double ResultComponent : Result)
+		{
+			double Error;
+			TwoSum(Sum, ResultComponent, Sum, Error);
+
+			if (Error != 0.0)
+			{
+				Grown.Add(Error);
+			}
+		}
+
+		if (Sum != 0.0)
+		{
+			Grown.Add(Sum);
+		}
+
+		Result = MoveTemp(Grown);
+	}
+
+	return Result;
+}
+
+static FExpansion Scale(const FExpansion& E, double B)
+{
+	FExpansion Result;
+
+	if (E.Num() == 0)
+	{
+		return Result;
+	}
+
+	double Sum, Error;
+	TwoProduct(E[0], B, Sum, Error);
+
+	if (Error != 0.0)
+	{
+		Result.Add(Error);
+	}
+
+	for (int32 Index = 1; Index < E.Num(); ++Index)
+	{
+		double Product, ProductError, PartialSum;
+		TwoProduct(E[Index], B, Product, ProductError);
+
+		TwoSum(Sum, ProductError, PartialSum, Error);
+		if (Error != 0.0)
+		{
+			Result.Add(Error);
+		}
+
+		FastTwoSum(Product, PartialSum, Sum, Error);
+		if (Error != 0.0)
+		{
+			Result.Add(Error);
+		}
+	}
+
+	if (Sum != 0.0)
+	{
+		Result.Add(Sum);
+	}
+
+	return Result;
+}
+
+static FExpansion Multiply(const FExpansion& E, const FExpansion& F)
+{
+	FExpansion Result;
+
+	for (const double Component : F)
+	{
+		Result = Add(Result, Scale(E, Component));
+	}
+
+	return Result;
+}
+
+// The largest component carries the sign of the whole expansion
+static double Estimate(const FExpansion& Expansion)
+{
+	return Expansion.Num() > 0 ? Expansion.Last() : 0.0;
+}
+
+double FGeometricPredicates::OrientExact(const FVector2D& A, const FVector2D& B, const FVector2D& C)
+{
+	const FExpansion Acx = MakeDifference(A.X, C.X);
+	const FExpansion Acy = MakeDifference(A.Y, C.Y);
+	const FExpansion Bcx = MakeDifference(B.X, C.X);
+	const FExpansion Bcy = MakeDifference(B.Y, C.Y);
+
+	return Estimate(Add(Multiply(Acx, Bcy), Negate(Multiply(Acy, Bcx))));
+}
+
+double FGeometricPredicates::InCircleExact(const FVector2D& A, const FVector2D& B, const FVector2D& C, const FVector2D& Point)
+{
+	const FExpansion Adx = MakeDifference(A.X, Point.X);
+	const FExpansion Ady = MakeDifference(A.Y, Point.Y);
+	const FExpansion Bdx = MakeDifference(B.X, Point.X);
+	const FExpansion Bdy = MakeDifference(B.Y, Point.Y);
+	const FExpansion Cdx = MakeDifference(C.X, Point.X);
+	const FExpansion Cdy = MakeDifference(C.Y, Point.Y);
+
+	const FExpansion ALift = Add(Multiply(Adx, Adx), Multiply(Ady, Ady));
+	const FExpansion BLift = Add(Multiply(Bdx, Bdx), Multiply(Bdy, Bdy));
+	const FExpansion CLift = Add(Multiply(Cdx, Cdx), Multiply(Cdy, Cdy));
+
+	const FExpansion BcCross = Add(Multiply(Bdx, Cdy), Negate(Multiply(Cdx, Bdy)));
+	const FExpansion CaCross = Add(Multiply(Cdx, Ady), Negate(Multiply(Adx, Cdy)));
+	const FExpansion AbCross = Add(Multiply(Adx, Bdy), Negate(Multiply(Bdx, Ady)));
+
+	return Estimate(Add(Add(Multiply(ALift, BcCross), Multiply(BLift, CaCross)), Multiply(CLift, AbCross)));
+}
@@ -0,0 +1,409 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Triangulation/ParallelDelaunayTriangulation.h"
+#include "Triangulation/GeometricPredicates.h"
+#include "Algo/BinarySearch.h"
+#include "Async/ParallelFor.h"
+
+// Below this many points per strip the stitched strip hulls cost more than the concurrency saves
+static constexpr int32 MinPointsPerStrip = 256;
+
+// Resolution of the X histogram the strip boundaries are picked from
+static constexpr int32 NumStripBins = 4096;
+
+void FParallelDelaunayTriangulation::Triangulate(TConstArrayView<FVector2D> Points, int32 NumStrips, TArray<FGeneratedTriangle>& OutTriangles, TArray<int32>& OutHalfEdgeTwins)
+{
+	const int32 NumPoints = Points.Num();
+
+	StitchPointIndices.Reset();
+	NumStrips = FMath::Min(NumStrips, NumPoints / MinPointsPerStrip);
+
+	if (NumStrips <= 1)
+	{
+		StitchTriangulation.Triangulate(Points);
+		StitchTriangulation.GetTriangles(OutTriangles, OutHalfEdgeTwins);
+		Stats = StitchTriangulation.GetStats();
+		return;
+	}
+
+	FDelaunayTriangulation::ComputeSuperTriangle(Points, SuperVertices[0], SuperVertices[1], SuperVertices[2]);
+
+	SplitStrips(Points, NumStrips);
+
+	StitchedPoints.SetNumUninitialized(NumPoints);
+
+	ParallelFor(Strips.Num(), [this, Points](int32 StripIndex)
+	{
+		TriangulateStrip(Points, StripIndex);
+	});
+
+	OutTriangles.Reset(2 * NumPoints);
+
+	for (const FStrip& Strip : Strips)
+	{
+		OutTriangles.Append(Strip.Triangles);
+	}
+
+	Stitch(Points, OutTriangles);
+
+	ComputeHalfEdgeTwins(OutTriangles, NumPoints, OutHalfEdgeTwins);
+
+	Stats = StitchTriangulation.GetStats();
+	Stats.NumStitchedPoints = StitchPointIndices.Num();
+
+	for (const FStrip& Strip : Strips)
+	{
+		Stats.Accumulate(Strip.Triangulation.GetStats());
+	}
+}
+
+void FParallelDelaunayTriangulation::SplitStrips(TConstArrayView<FVector2D> Points, int32 NumStrips)
+{
+	double MinX = Points[0].X;
+	double MaxX = Points[0].X;
+
+	for (const FVector2D& Point : Points)
+	{
+		MinX = FMath::Min(MinX, Point.X);
+		MaxX = FMath::Max(MaxX, Point.X);
+	}
+
+	// Start the strips at the X histogram quantiles so they get about the same number of points
+	StripStarts.Reset(NumStrips);
+	StripStarts.Add(TNumericLimits<double>::Lowest());
+
+	if (MaxX > MinX)
+	{
+		const double BinScale = NumStripBins / (MaxX - MinX);
+
+		TArray<int32> BinCounts;
+		BinCounts.Init(0, NumStripBins);
+
+		for (const FVector2D& Point : Points)
+		{
+			++BinCounts[FMath::Min(int32((Point.X - MinX) * BinScale), NumStripBins - 1)];
+		}
+
+		int64 NumBinnedPoints = 0;
+
+		for (int32 Bin = 0; Bin < NumStripBins - 1 && StripStarts.Num() < NumStrips; ++Bin)
+		{
+			NumBinnedPoints += BinCounts[Bin];
+
+			if (NumBinnedPoints * NumStrips >= int64(StripStarts.Num()) * Points.Num())
+			{
+				StripStarts.Add(MinX + (Bin + 1) / BinScale);
+			}
+		}
+	}
+
+	Strips.SetNum(StripStarts.Num());
+
+	for (FStrip& Strip : Strips)
+	{
+		Strip.PointIndices.Reset(Points.Num() / Strips.Num() + Points.Num() / 16);
+		Strip.Points.Reset(Points.Num() / Strips.Num() + Points.Num() / 16);
+	}
+
+	// Membership is decided against the same boundaries the certification uses, not against the histogram bins
+	for (int32 Index = 0; Index < Points.Num(); ++Index)
+	{
+		FStrip& Strip = Strips[Algo::UpperBound(StripStarts, Points[Index].X) - 1];
+		Strip.PointIndices.Add(Index);
+		Strip.Points.Add(Points[Index]);
+	}
+}
+
+void FParallelDelaunayTriangulation::TriangulateStrip(TConstArrayView<FVector2D> Points, int32 StripIndex)
+{
+	FStrip& Strip = Strips[StripIndex];
+
+	Strip.Triangulation.Triangulate(Strip.Points, SuperVertices[0], SuperVertices[1], SuperVertices[2]);
+
+	TArray<FGeneratedTriangle> LocalTriangles;
+	TArray<int32> LocalHalfEdgeTwins;
+	Strip.Triangulation.GetTriangles(LocalTriangles, LocalHalfEdgeTwins);
+
+	enum class EPointState : uint8
+	{
+		NoTriangle,
+		Certified,
+		Stitched,
+	};
+
+	// A point is certified only when the whole fan around it is, which also excludes the strip hull where the fan is open
+	TArray<EPointState> PointStates;
+	PointStates.Init(EPointState::NoTriangle, Strip.Points.Num());
+
+	Strip.Triangles.Reset(LocalTriangles.Num());
+
+	for (int32 Triangle = 0; Triangle < LocalTriangles.Num(); ++Triangle)
+	{
+		const FGeneratedTriangle& LocalTriangle = LocalTriangles[Triangle];
+		const FGeneratedTriangle GlobalTriangle(Strip.PointIndices[LocalTriangle.Vertex1], Strip.PointIndices[LocalTriangle.Vertex2], Strip.PointIndices[LocalTriangle.Vertex3]);
+
+		const bool bCertified = IsInsideStrip(Points, GlobalTriangle);
+
+		if (bCertified)
+		{
+			Strip.Triangles.Add(GlobalTriangle);
+		}
+
+		for (int32 Corner = 0; Corner < 3; ++Corner)
+		{
+			EPointState& State = PointStates[LocalTriangle[Corner]];
+
+			if (!bCertified || LocalHalfEdgeTwins[3 * Triangle + Corner] == INDEX_NONE)
+			{
+				State = EPointState::Stitched;
+				PointStates[LocalTriangle[(Corner + 1) % 3]] = EPointState::Stitched;
+			}
+			else if (State == EPointState::NoTriangle)
+			{
+				State = EPointState::Certified;
+			}
+		}
+	}
+
+	// Every strip writes the flags of its own points only
+	for (int32 Index = 0; Index < Strip.PointIndices.Num(); ++Index)
+	{
+		StitchedPoints[Strip.PointIndices[Index]] = PointStates[Index] != EPointState::Certified;
+	}
+}
+
+void FParallelDelaunayTriangulation::Stitch(TConstArrayView<FVector2D> Points, TArray<FGeneratedTriangle>& OutTriangles)
+{
+	StitchPoints.Reset();
+
+	for (int32 Index = 0; Index < Points.Num(); ++Index)
+	{
+		if (StitchedPoints[Index])
+		{
+			StitchPointIndices.Add(Index);
+			StitchPoints.Add(Points[Index]);
+		}
+	}
+
+	BuildUnstitchedGrid(Points);
+
+	StitchTriangulation.Triangulate(StitchPoints, SuperVertices[0], SuperVertices[1], SuperVertices[2]);
+
+	TArray<FGeneratedTriangle> LocalTriangles;
+	TArray<int32> LocalHalfEdgeTwins;
+	StitchTriangulation.GetTriangles(LocalTriangles, LocalHalfEdgeTwins);
+
+	// Every triangle of the whole set that no strip certified has its corners stitched and no point in its circumcircle,
+	// the ones spanning unstitched points are rejected by the grid query
+	for (const FGeneratedTriangle& LocalTriangle : LocalTriangles)
+	{
+		const FGeneratedTriangle GlobalTriangle(StitchPointIndices[LocalTriangle.Vertex1], StitchPointIndices[LocalTriangle.Vertex2], StitchPointIndices[LocalTriangle.Vertex3]);
+
+		if (!IsInsideStrip(Points, GlobalTriangle) && !HasUnstitchedPointInCircle(Points, GlobalTriangle))
+		{
+			OutTriangles.Add(GlobalTriangle);
+		}
+	}
+}
+
+bool FParallelDelaunayTriangulation::IsInsideStrip(TConstArrayView<FVector2D> Points, const FGeneratedTriangle& Triangle) const
+{
+	FVector2D Center;
+	double Radius;
+	Triangle.ComputeCircumCircle(Points, Center, Radius);
+
+	const double Margin = 1.0e-9 * FMath::Abs(Center.X) + 1.0e-6 * Radius;
+	const double MinX = Center.X - Radius - Margin;
+	const double MaxX = Center.X + Radius + Margin;
+
+	// Also false for the infinite or NaN circles of degenerate triangles
+	if (!(MinX > TNumericLimits<double>::Lowest() && MaxX < TNumericLimits<double>::Max()))
+	{
+		return false;
+	}
+
+	const int32 Strip = Algo::UpperBound(StripStarts, MinX) - 1;
+	return Strip + 1 == StripStarts.Num() || MaxX < StripStarts[Strip + 1];
+}
+
+bool FParallelDelaunayTriangulation::HasUnstitchedPointInCircle(TConstArrayView<FVector2D> Points, const FGeneratedTriangle& Triangle) const
+{
+	if (GridPoints.Num() == 0)
+	{
+		return false;
+	}
+
+	FVector2D Center;
+	double Radius;
+	Triangle.ComputeCircumCircle(Points, Center, Radius);
+
+	const bool bBounded = FMath::IsFinite(Center.X) && FMath::IsFinite(Center.Y) && FMath::IsFinite(Radius);
+	const double CellSize = 1.0 / GridInvCellSize;
+
+	auto ClampCell = [this](double Coordinate, double Min)
+	{
+		return int32(FMath::Clamp((Coordinate - Min) * GridInvCellSize, 0.0, double(GridNumCells - 1)));
+	};
+
+	// One more cell on every side absorbs the rounding of the circle, the in-circle test decides
+	const int32 MinCellX = bBounded ? FMath::Max(ClampCell(Center.X - Radius, GridMin.X) - 1, 0) : 0;
+	const int32 MaxCellX = bBounded ? FMath::Min(ClampCell(Center.X + Radius, GridMin.X) + 1, GridNumCells - 1) : GridNumCells - 1;
+
+	const FVector2D& A = Points[Triangle.Vertex1];
+	const FVector2D& B = Points[Triangle.Vertex2];
+	const FVector2D& C = Points[Triangle.Vertex3];
+
+	for (int32 CellX = MinCellX; CellX <= MaxCellX; ++CellX)
+	{
+		int32 MinCellY = 0;
+		int32 MaxCellY = GridNumCells - 1;
+
+		if (bBounded)
+		{
+			// Only the cells of the column under the circle, a large circle mostly outside the points only touches a few of them
+			const double ColumnMinX = GridMin.X + CellX * CellSize;
+			const double DeltaX = FMath::Max(0.0, FMath::Max(ColumnMinX - Center.X, Center.X - (ColumnMinX + CellSize)));
+
+			if (DeltaX > Radius + CellSize)
+			{
+				continue;
+			}
+
+			const double HalfHeight = FMath::Sqrt(FMath::Max(0.0, Radius * Radius - DeltaX * DeltaX));
+			MinCellY = FMath::Max(ClampCell(Center.Y - HalfHeight, GridMin.Y) - 1, 0);
+			MaxCellY = FMath::Min(ClampCell(Center.Y + HalfHeight, GridMin.Y) + 1, GridNumCells - 1);
+		}
+
+		const int32 FirstCell = CellX * GridNumCells;
+
+		for (int32 GridIndex = GridCellOffsets[FirstCell + MinCellY]; GridIndex < GridCellOffsets[FirstCell + MaxCellY + 1]; ++GridIndex)
+		{
+			if (FGeometricPredicates::InCircle(A, B, C, Points[GridPoints[GridIndex]]) > 0.0)
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+void FParallelDelaunayTriangulation::BuildUnstitchedGrid(TConstArrayView<FVector2D> Points)
+{
+	const int32 NumUnstitched = Points.Num() - StitchPointIndices.Num();
+
+	FVector2D GridMax = Points[0];
+	GridMin = Points[0];
+
+	for (const FVector2D& Point : Points)
+	{
+		GridMin.X = FMath::Min(GridMin.X, Point.X);
+		GridMin.Y = FMath::Min(GridMin.Y, Point.Y);
+		GridMax.X = FMath::Max(GridMax.X, Point.X);
+		GridMax.Y = FMath::Max(GridMax.Y, Point.Y);
+	}
+
+	// About two points per cell
+	GridNumCells = FMath::Max(1, FMath::CeilToInt(FMath::Sqrt(NumUnstitched / 2.0)));
+	const double Extend = FMath::Max(GridMax.X - GridMin.X, GridMax.Y - GridMin.Y);
+	GridInvCellSize = Extend > 0.0 ? GridNumCells / Extend : 1.0;
+
+	// Cells are ordered by column then row, so a column range of rows is a single range of GridPoints
+	auto GetCell = [this](const FVector2D& Point)
+	{
+		const int32 CellX = FMath::Min(int32((Point.X - GridMin.X) * GridInvCellSize), GridNumCells - 1);
+		const int32 CellY = FMath::Min(int32((Point.Y - GridMin.Y) * GridInvCellSize), GridNumCells - 1);
+		return CellX * GridNumCells + CellY;
+	};
+
+	GridCellOffsets.Reset();
+	GridCellOffsets.Init(0, GridNumCells * GridNumCells + 1);
+
+	for (int32 Index = 0; Index < Points.Num(); ++Index)
+	{
+		if (!StitchedPoints[Index])
+		{
+			++GridCellOffsets[GetCell(Points[Index]) + 1];
+		}
+	}
+
+	for (int32 Cell = 0; Cell < GridNumCells * GridNumCells; ++Cell)
+	{
+		GridCellOffsets[Cell + 1] += GridCellOffsets[Cell];
+	}
+
+	TArray<int32> CellCursors(GridCellOffsets.GetData(), GridNumCells * GridNumCells);
+	GridPoints.SetNumUninitialized(NumUnstitched);
+
+	for (int32 Index = 0; Index < Points.Num(); ++Index)
+	{
+		if (!StitchedPoints[Index])
+		{
+			GridPoints[CellCursors[GetCell(Points[Index])]++] = Index;
+		}
+	}
+}
+
+void FParallelDelaunayTriangulation::ComputeHalfEdgeTwins(const TArray<FGeneratedTriangle>& Triangles, int32 NumPoints, TArray<int32>& OutHalfEdgeTwins)
+{
+	const int32 NumHalfEdges = 3 * Triangles.Num();
+
+	auto GetStart = [&Triangles](int32 HalfEdge)
+	{
+		return Triangles[HalfEdge / 3][HalfEdge % 3];
+	};
+
+	// Bucket the half-edges by their lower point, twins land in the same bucket
+	TArray<int32> BucketOffsets;
+	BucketOffsets.Init(0, NumPoints + 1);
+
+	for (int32 HalfEdge = 0; HalfEdge < NumHalfEdges; ++HalfEdge)
+	{
+		++BucketOffsets[FMath::Min(GetStart(HalfEdge), GetStart(FGeneratedTriangle::NextHalfEdge(HalfEdge))) + 1];
+	}
+
+	for (int32 Point = 0; Point < NumPoints; ++Point)
+	{
+		BucketOffsets[Point + 1] += BucketOffsets[Point];
+	}
+
+	TArray<int32> BucketCursors(BucketOffsets.GetData(), NumPoints);
+	TArray<int32> BucketHalfEdges;
+	BucketHalfEdges.SetNumUninitialized(NumHalfEdges);
+
+	for (int32 HalfEdge = 0; HalfEdge < NumHalfEdges; ++HalfEdge)
+	{
+		BucketHalfEdges[BucketCursors[FMath::Min(GetStart(HalfEdge), GetStart(FGeneratedTriangle::NextHalfEdge(HalfEdge)))]++] = HalfEdge;
+	}
+
+	OutHalfEdgeTwins.Reset();
+	OutHalfEdgeTwins.Init(INDEX_NONE, NumHalfEdges);
+
+	for (int32 Point = 0; Point < NumPoints; ++Point)
+	{
+		for (int32 Index = BucketOffsets[Point]; Index < BucketOffsets[Point + 1]; ++Index)
+		{
+			const int32 HalfEdge = BucketHalfEdges[Index];
+
+			if (OutHalfEdgeTwins[HalfEdge] != INDEX_NONE)
+			{
+				continue;
+			}
+
+			const int32 Start = GetStart(HalfEdge);
+			const int32 End = GetStart(FGeneratedTriangle::NextHalfEdge(HalfEdge));
+
+			for (int32 OtherIndex = Index + 1; OtherIndex < BucketOffsets[Point + 1]; ++OtherIndex)
+			{
+				const int32 OtherHalfEdge = BucketHalfEdges[OtherIndex];
+
+				if (GetStart(OtherHalfEdge) == End && GetStart(FGeneratedTriangle::NextHalfEdge(OtherHalfEdge)) == Start)
+				{
+					OutHalfEdgeTwins[HalfEdge] = OtherHalfEdge;
+					OutHalfEdgeTwins[OtherHalfEdge] = HalfEdge;
+					break;
+				}
+			}
+		}
+	}
+}
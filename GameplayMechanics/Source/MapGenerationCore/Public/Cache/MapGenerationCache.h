@@ -0,0 +1,63 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/SecureHash.h"
+#include "MapGenerationSettings.h"
+#include "MapGenerationView.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Cached map file mapped in memory. The view points straight into the mapping, it stays valid as long as the file object.
+ */
+class MAPGENERATIONCORE_API FMapGenerationCacheFile
+{
+public:
+	~FMapGenerationCacheFile();
+
+	const FMapGenerationView& GetView() const
+	{
+		return View;
+	}
+
+private:
+	friend class FMapGenerationCache;
+
+	FMapGenerationCacheFile(TUniquePtr<IMappedFileHandle>&& InHandle, TUniquePtr<IMappedFileRegion>&& InRegion);
+
+	TUniquePtr<IMappedFileHandle> Handle;
+	TUniquePtr<IMappedFileRegion> Region;
+
+	FMapGenerationView View;
+};
+
+/**
+ * On-disk cache of generated maps, one file per map named after the hash of the settings that generate it.
+ * The files hold the generated arrays with their in-memory layout, so a cached map is memory mapped and used in place.
+ */
+class MAPGENERATIONCORE_API FMapGenerationCache
+{
+public:
+	// Layout of the files and version of the generation, bump it whenever either changes what a set of settings produces
+	static constexpr uint32 FormatVersion = 1;
+
+	explicit FMapGenerationCache(const FString& InDirectory);
+
+	// Hash of the settings changing the generated map, the ones only changing how it is computed are left out
+	static FSHAHash HashSettings(const FMapGenerationSettings& Settings);
+
+	FString GetFilename(const FMapGenerationSettings& Settings) const;
+
+	// Writes the map generated with Settings, through a temporary file so a load never sees a partial one
+	bool Save(const FMapGenerationSettings& Settings, const FMapGenerationView& View) const;
+
+	// Maps the cached map of Settings, null when it is not cached, the file does not match the current format or one of
+	// its indices is out of range
+	TUniquePtr<FMapGenerationCacheFile> Load(const FMapGenerationSettings& Settings) const;
+
+private:
+	FString Directory;
+};
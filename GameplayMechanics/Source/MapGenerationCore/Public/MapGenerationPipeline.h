@@ -0,0 +1,142 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MapGenerationSettings.h"
+#include "MapGenerationView.h"
+#include "Profiling/MapGenerationStats.h"
+#include "Routing/RouteSearch.h"
+#include "Sampling/SampleGrid.h"
+#include "Triangulation/DelaunayTriangulation.h"
+#include "Triangulation/ParallelDelaunayTriangulation.h"
+#include "Structs/GeneratedEdge.h"
+#include "Structs/GeneratedNode.h"
+#include "Structs/GeneratedTriangles.h"
+
+/**
+ * Engine independent map generation: Poisson disk sampling -> Delaunay triangulation -> path graph -> route.
+ * Every stage reads the output of the previous one from the pipeline, so they can be run (and timed) one by one.
+ */
+class MAPGENERATIONCORE_API FMapGenerationPipeline
+{
+public:
+	FMapGenerationPipeline();
+	explicit FMapGenerationPipeline(const FMapGenerationSettings& InSettings);
+
+	// Runs every stage in order
+	void Generate();
+
+	void PoisonDiskSampling();
+	// Samples the cells [MinCell, EndCell) of the region only, keeping away from FixedPoints and growing from them and from
+	// the centre of the cells. A larger area sampled piece by piece this way has no gap between the pieces.
+	void PoisonDiskSamplingCells(FRandomStream& Stream, TConstArrayView<FVector2D> FixedPoints, const FIntPoint& MinCell, const FIntPoint& EndCell, TArray<FVector2D>& OutPoints);
+	bool IsCandidateValid(const FVector2D& Candidate) const;
+	void DelaunaryTriangulation();
+	// Original O(n^2) Bowyer-Watson scan, kept as the reference the benchmark compares against
+	void DelaunaryTriangulationBowyerWatson();
+	void GeneratePaths();
+	void FindRoutes();
+
+	// Edits of a generated map. They repair the triangles and the path links around the edited point, patch the generated
+	// arrays and only search the route again when the last search went through the edit.
+	// Adds a point and returns its index, INDEX_NONE when it lies on another point or far outside the map
+	int32 AddPoint(const FVector2D& Position);
+	// Removes a point other than StartPoint and EndPoint, the last point takes its index like with TArray::RemoveAtSwap
+	bool RemovePoint(int32 Point);
+	// Fails when NewPosition lies on another point or far outside the map
+	bool MovePoint(int32 Point, const FVector2D& NewPosition);
+	bool SetStartPoint(const FVector2D& Position);
+	bool SetEndPoint(const FVector2D& Position);
+
+	// Indices into Paths of the children of a node
+	TConstArrayView<int32> GetChildNodes(int32 Node) const
+	{
+		return MakeArrayView(PathChildNodes.GetData() + Paths[Node].FirstChildNode, Paths[Node].NumChildNodes);
+	}
+
+	// View over the generated arrays, valid until the next stage or edit. Edges is empty while outdated by an edit.
+	FMapGenerationView GetView() const;
+	// Replaces the generated data with a copy of View, like a map generated with the current settings
+	void LoadView(const FMapGenerationView& View);
+
+	// Bytes currently allocated by the generated data
+	SIZE_T GetAllocatedSize() const;
+
+public:
+	FMapGenerationSettings Settings;
+
+	TArray<FVector2D> GeneratedPoints;
+
+	FSampleGrid Grid;
+
+	TArray<FGeneratedTriangle> Triangles;
+	// Twin of every triangle half-edge (3 per triangle), INDEX_NONE on the border of the triangulation
+	TArray<int32> HalfEdgeTwins;
+
+	// Every edge of the triangulation once, as (lower point, higher point) sorted by lower then higher point.
+	// The point edits leave the edges outdated until the next GeneratePaths.
+	TArray<FGeneratedEdge> Edges;
+	// Edges touching point V are VertexEdges[VertexEdgeOffsets[V]] to VertexEdges[VertexEdgeOffsets[V + 1] - 1]
+	TArray<int32> VertexEdgeOffsets;
+	TArray<int32> VertexEdges;
+
+	// One node per generated point, with the same index
+	TArray<FGeneratedNode> Paths;
+	// Children of every node of Paths, one range per node
+	TArray<int32> PathChildNodes;
+	// Indices into Paths from the start node to the end node, empty when the end can not be reached
+	TArray<int32> Routes;
+
+	FVector2D StartPoint;
+	FVector2D EndPoint;
+	// Indices of StartPoint and EndPoint in GeneratedPoints
+	int32 StartPointIndex = INDEX_NONE;
+	int32 EndPointIndex = INDEX_NONE;
+
+	// Timings and counters of the last run of each stage, an edit searching the route again counts as a run of FindRoutes
+	FMapGenerationStats Stats;
+
+private:
+	// Samples the region in tiles processed concurrently, see FMapGenerationSettings::bParallelSampling
+	void PoisonDiskSamplingTiles(int Iterations);
+
+	// Grows samples from SpawnPoints, only accepting the ones in the cells [MinCell, EndCell)
+	void SampleFromSpawnPoints(FRandomStream& Stream, TArray<FVector2D>& SpawnPoints, const FIntPoint& MinCell, const FIntPoint& EndCell, int Iterations, TArray<FVector2D>& OutPoints, FMapSamplingStats& OutStats);
+
+	// Random candidate around SpawnPoint, at one to two radius from it
+	FVector2D GenerateCandidate(FRandomStream& Stream, const FVector2D& SpawnPoint) const;
+
+	// Fills Edges and the point to edge adjacency from Triangles
+	void BuildEdges();
+	// Fills the point to edge adjacency from Edges
+	void BuildVertexEdges();
+
+	// Makes Triangulation follow Triangles before an edit, triangulating again when they came from another algorithm
+	void PrepareEdit();
+	// Brings the triangles, edges, path links and route up to date after Triangulation was edited
+	void FinishEdit(bool bEndPointsChanged);
+	// Links the given nodes to their neighbours in the triangulation again
+	void UpdatePathNodes(TConstArrayView<int32> Nodes);
+	// Drops the child ranges left behind by UpdatePathNodes
+	void CompactPathChildNodes();
+
+private:
+	FRandomStream Random;
+
+	FDelaunayTriangulation Triangulation;
+	FParallelDelaunayTriangulation ParallelTriangulation;
+
+	// Whether Triangulation holds GeneratedPoints and exports to Triangles
+	bool bEditableTriangulation = false;
+	bool bEdgesOutdated = false;
+
+	// Entries of PathChildNodes no node points to anymore
+	int32 NumStalePathChildNodes = 0;
+
+	// Scratch of the edits
+	TArray<int32> ChangedPoints;
+	TArray<int32> NeighbourPoints;
+
+	FRouteSearch RouteSearch;
+};
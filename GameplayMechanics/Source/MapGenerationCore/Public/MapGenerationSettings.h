@@ -0,0 +1,30 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Input parameters of the map generation pipeline. The output is fully deterministic for a given set of values.
+ */
+struct MAPGENERATIONCORE_API FMapGenerationSettings
+{
+	int Seed = 123456789;
+	float GridExtend = 50.0f;
+	float SphereRadius = 5.0f;
+	int Iterations = 50000;
+	int NumSampleBeforeRejection = 1;
+	bool bCheckWellGenerated = false;
+	// Tests the sampling candidates in SIMD batches, the generated points are the same either way
+	bool bBatchCandidateTests = true;
+	// Samples square tiles of the region on several threads. The points differ from the single threaded sampling,
+	// but only depend on the other settings, not on the number of threads. Iterations is split between the tiles.
+	bool bParallelSampling = false;
+	// Threads used by the parallel sampling, 0 uses every core
+	int NumSamplingThreads = 0;
+	// Triangulates vertical strips of the points on several threads and stitches them, the triangles are the same as the
+	// single threaded triangulation but in another order
+	bool bParallelTriangulation = false;
+	// Threads used by the parallel triangulation, 0 uses every core
+	int NumTriangulationThreads = 0;
+};
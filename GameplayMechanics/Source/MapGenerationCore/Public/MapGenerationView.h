@@ -0,0 +1,34 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Structs/GeneratedEdge.h"
+#include "Structs/GeneratedNode.h"
+#include "Structs/GeneratedTriangles.h"
+
+/**
+ * Read only view of a generated map, over the arrays of a FMapGenerationPipeline or over a cached map file.
+ * Fields match the pipeline members of the same name.
+ */
+struct FMapGenerationView
+{
+	TConstArrayView<FVector2D> GeneratedPoints;
+	TConstArrayView<FGeneratedTriangle> Triangles;
+	TConstArrayView<int32> HalfEdgeTwins;
+	TConstArrayView<FGeneratedEdge> Edges;
+	TConstArrayView<FGeneratedNode> Paths;
+	TConstArrayView<int32> PathChildNodes;
+	TConstArrayView<int32> Routes;
+
+	FVector2D StartPoint = FVector2D::ZeroVector;
+	FVector2D EndPoint = FVector2D::ZeroVector;
+	int32 StartPointIndex = INDEX_NONE;
+	int32 EndPointIndex = INDEX_NONE;
+
+	// Indices into Paths of the children of a node
+	TConstArrayView<int32> GetChildNodes(int32 Node) const
+	{
+		return PathChildNodes.Slice(Paths[Node].FirstChildNode, Paths[Node].NumChildNodes);
+	}
+};
@@ -0,0 +1,81 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MapGenerationView.h"
+
+/**
+ * Flat navigation graph exported from the path nodes of a generated map, independent of the pipeline that generated it.
+ * Node positions are stored per axis, the links in compressed rows: the edges leaving node N are
+ * [EdgeOffsets[N], EdgeOffsets[N + 1]) of EdgeTargets and EdgeWeights, the weight being the length of the link.
+ * A uniform grid over the nodes answers nearest node queries.
+ *
+ * The graph is never written once built, so any number of threads can query it at the same time, each route search
+ * bringing its own FRouteSearch.
+ */
+class MAPGENERATIONCORE_API FMapNavigationGraph
+{
+public:
+	// Bump whenever the serialized layout changes. Graphs of other versions, truncated or with out of range indices are
+	// skipped and load empty, leaving the archive readable past them.
+	static constexpr int32 FormatVersion = 2;
+
+	FMapNavigationGraph();
+
+	// Exports the path nodes and child links of Map, replacing the previous graph
+	void Build(const FMapGenerationView& Map);
+
+	void Reset();
+
+	int32 GetNumNodes() const
+	{
+		return PositionsX.Num();
+	}
+
+	int32 GetNumEdges() const
+	{
+		return EdgeTargets.Num();
+	}
+
+	FVector2D GetNodePosition(int32 Node) const
+	{
+		return FVector2D(PositionsX[Node], PositionsY[Node]);
+	}
+
+	// Nodes the node links to
+	TConstArrayView<int32> GetEdgeTargets(int32 Node) const
+	{
+		return MakeArrayView(EdgeTargets.GetData() + EdgeOffsets[Node], EdgeOffsets[Node + 1] - EdgeOffsets[Node]);
+	}
+
+	// Closest node to Position, INDEX_NONE when the graph is empty
+	int32 FindNearestNode(const FVector2D& Position) const;
+
+	SIZE_T GetAllocatedSize() const;
+
+	friend MAPGENERATIONCORE_API FArchive& operator<<(FArchive& Ar, FMapNavigationGraph& Graph);
+
+public:
+	TArray<float> PositionsX;
+	TArray<float> PositionsY;
+
+	TArray<int32> EdgeOffsets;
+	TArray<int32> EdgeTargets;
+	TArray<float> EdgeWeights;
+
+private:
+	// Buckets the nodes in cells of about one node each
+	void BuildGrid();
+
+	FIntPoint GetCell(const FVector2D& Position) const;
+
+private:
+	FVector2D GridMin = FVector2D::ZeroVector;
+	double GridCellSize = 1.0;
+	FIntPoint GridNumCells = FIntPoint(0);
+
+	// Nodes in cell C are GridNodes[GridCellOffsets[C], GridCellOffsets[C + 1]), cells are stored row by row along X
+	TArray<int32> GridCellOffsets;
+	TArray<int32> GridNodes;
+};
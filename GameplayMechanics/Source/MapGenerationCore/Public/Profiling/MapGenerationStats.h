@@ -0,0 +1,80 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+
+// "stat MapGeneration" shows the stages of the last generation, their scopes also show in Unreal Insights
+DECLARE_STATS_GROUP(TEXT("MapGeneration"), STATGROUP_MapGeneration, STATCAT_Advanced);
+
+struct MAPGENERATIONCORE_API FMapSamplingStats
+{
+	double Time = 0.0;
+
+	// A candidate counts as tested when IsCandidateValid would have been called on it, the batched tests count the same
+	int64 NumTestedCandidates = 0;
+	int64 NumAcceptedCandidates = 0;
+	int64 NumRejectedCandidates = 0;
+	// Spawn points dropped after none of their candidates was accepted
+	int64 NumRetiredSpawnPoints = 0;
+
+	void Accumulate(const FMapSamplingStats& Other);
+};
+
+struct MAPGENERATIONCORE_API FMapTriangulationStats
+{
+	double Time = 0.0;
+
+	int64 NumInsertedPoints = 0;
+	// Triangles created and removed by the insertions, the cavity of an insertion is the triangles it removes
+	int64 NumCreatedTriangles = 0;
+	int64 NumRemovedTriangles = 0;
+	int32 MaxCavityTriangles = 0;
+	// Points triangulated a second time by the stitching of the parallel triangulation
+	int32 NumStitchedPoints = 0;
+
+	double GetMeanCavityTriangles() const
+	{
+		return NumInsertedPoints > 0 ? double(NumRemovedTriangles) / double(NumInsertedPoints) : 0.0;
+	}
+
+	void Accumulate(const FMapTriangulationStats& Other);
+};
+
+struct FMapPathStats
+{
+	double Time = 0.0;
+
+	int32 NumNodes = 0;
+	int32 NumChildLinks = 0;
+	// Whether the edges outdated by a point edit were built again first
+	bool bRebuiltEdges = false;
+};
+
+struct FMapRouteStats
+{
+	double Time = 0.0;
+
+	// Nodes popped from the open set and whose children were followed
+	int32 NumExpandedNodes = 0;
+	int32 MaxOpenNodes = 0;
+	int32 NumRouteNodes = 0;
+};
+
+/**
+ * Timings and counters of the last run of every stage of FMapGenerationPipeline, each stage resets its own part.
+ * Times are in seconds.
+ */
+struct FMapGenerationStats
+{
+	FMapSamplingStats Sampling;
+	FMapTriangulationStats Triangulation;
+	FMapPathStats Paths;
+	FMapRouteStats Route;
+
+	double GetTotalTime() const
+	{
+		return Sampling.Time + Triangulation.Time + Paths.Time + Route.Time;
+	}
+};
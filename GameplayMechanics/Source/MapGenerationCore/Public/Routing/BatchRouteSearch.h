@@ -0,0 +1,79 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Routing/RouteSearch.h"
+
+struct FRouteQuery
+{
+	int32 Start = INDEX_NONE;
+	int32 Goal = INDEX_NONE;
+
+	FRouteQuery()
+	{
+	}
+
+	FRouteQuery(int32 InStart, int32 InGoal) :
+		Start(InStart),
+		Goal(InGoal)
+	{
+	}
+};
+
+/**
+ * Routes of a batch of queries in a single buffer. The route of query Q is
+ * RouteNodes[RouteOffsets[Q], RouteOffsets[Q + 1]), empty when its goal can not be reached.
+ */
+struct FRouteBatchResult
+{
+	TArray<int32> RouteOffsets;
+	TArray<int32> RouteNodes;
+
+	int32 NumRoutes() const
+	{
+		return FMath::Max(0, RouteOffsets.Num() - 1);
+	}
+
+	TConstArrayView<int32> GetRoute(int32 Query) const
+	{
+		return MakeArrayView(RouteNodes.GetData() + RouteOffsets[Query], RouteOffsets[Query + 1] - RouteOffsets[Query]);
+	}
+};
+
+/**
+ * Answers many route queries over the same path nodes on several threads. Every worker owns a FRouteSearch kept between
+ * batches, so once warmed up a batch only allocates when the routes outgrow the buffers of the previous ones.
+ * The nodes are only read, one batch can run at a time per FBatchRouteSearch.
+ */
+class MAPGENERATIONCORE_API FBatchRouteSearch
+{
+public:
+	// Fills OutRoutes with the route of every query, in query order. NumThreads 0 uses every core.
+	void FindRoutes(TConstArrayView<FGeneratedNode> Nodes, TConstArrayView<int32> ChildNodes, TConstArrayView<FRouteQuery> Queries, int32 NumThreads, FRouteBatchResult& OutRoutes);
+
+	// Same over an exported navigation graph
+	void FindRoutes(const FMapNavigationGraph& Graph, TConstArrayView<FRouteQuery> Queries, int32 NumThreads, FRouteBatchResult& OutRoutes);
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	// FindRoute(Search, Start, Goal, OutRoute) runs a single query with the search of a worker
+	template <typename FindRouteType>
+	void Run(TConstArrayView<FRouteQuery> Queries, int32 NumThreads, FRouteBatchResult& OutRoutes, const FindRouteType& FindRoute);
+
+	struct FWorker
+	{
+		FRouteSearch Search;
+		TArray<int32> Route;
+		// Routes found by this worker, one after the other
+		TArray<int32> RouteNodes;
+	};
+
+	// Indirect so the searches of the workers do not move when more are added
+	TArray<TUniquePtr<FWorker>> Workers;
+
+	// Worker that answered each query and where its route starts in the nodes of that worker
+	TArray<int32> QueryWorkers;
+	TArray<int32> QueryRouteStarts;
+};
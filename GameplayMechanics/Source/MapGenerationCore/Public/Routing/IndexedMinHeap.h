@@ -0,0 +1,56 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Binary min heap of item indices in [0, NumItems) ordered by a key.
+ * The heap position of every item is tracked, so the key of a queued item can be decreased in place.
+ */
+class MAPGENERATIONCORE_API FIndexedMinHeap
+{
+public:
+	// Empties the heap and makes room for items in [0, NumItems)
+	void Init(int32 NumItems);
+
+	// Empties the heap, only touches the items still queued
+	void Reset();
+
+	bool IsEmpty() const
+	{
+		return Entries.Num() == 0;
+	}
+
+	int32 Num() const
+	{
+		return Entries.Num();
+	}
+
+	bool Contains(int32 Item) const
+	{
+		return ItemPositions[Item] != INDEX_NONE;
+	}
+
+	// Queues the item, or lowers its key when it is already queued with a higher one
+	void Push(int32 Item, double Key);
+
+	// Removes and returns the item with the lowest key
+	int32 Pop();
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	void SiftUp(int32 Position);
+	void SiftDown(int32 Position);
+
+private:
+	struct FEntry
+	{
+		double Key;
+		int32 Item;
+	};
+
+	TArray<FEntry> Entries;
+	TArray<int32> ItemPositions;
+};
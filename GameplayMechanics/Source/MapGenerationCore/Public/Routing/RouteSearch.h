@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Routing/IndexedMinHeap.h"
+#include "Structs/GeneratedNode.h"
+
+class FMapNavigationGraph;
+
+/**
+ * A* over path nodes, following the child links weighted by their length and guided by the straight distance to the goal.
+ * Scores are kept in dense per node arrays and only the nodes touched by a search are reset, so repeated searches do not allocate.
+ */
+class MAPGENERATIONCORE_API FRouteSearch
+{
+public:
+	// Fills OutRoute with the node indices from Start to Goal, returns false and leaves it empty when Goal can not be reached.
+	// ChildNodes is the array the FirstChildNode/NumChildNodes ranges of the nodes point into.
+	bool FindRoute(TConstArrayView<FGeneratedNode> Nodes, TConstArrayView<int32> ChildNodes, int32 Start, int32 Goal, TArray<int32>& OutRoute);
+
+	// Same search over an exported navigation graph, following its edges weighted by their stored weight
+	bool FindRoute(const FMapNavigationGraph& Graph, int32 Start, int32 Goal, TArray<int32>& OutRoute);
+
+	// Whether the last search reached Node. A route only depends on the links and positions of the nodes its search reached,
+	// so edits of the other nodes leave it unchanged.
+	bool WasNodeReached(int32 Node) const
+	{
+		return CostFromStart.IsValidIndex(Node) && CostFromStart[Node] != TNumericLimits<double>::Max();
+	}
+
+	// Nodes expanded by the last search, and the most nodes its open set held at once
+	int32 GetNumExpandedNodes() const
+	{
+		return NumExpandedNodes;
+	}
+
+	int32 GetMaxOpenNodes() const
+	{
+		return MaxOpenNodes;
+	}
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	// GraphType gives the node count and positions, and visits the children of a node with the cost of reaching them
+	template <typename GraphType>
+	bool Search(const GraphType& Graph, int32 Start, int32 Goal, TArray<int32>& OutRoute);
+
+	void Prepare(int32 NumNodes);
+	void ResetTouchedNodes();
+
+private:
+	TArray<double> CostFromStart;
+	TArray<int32> Parents;
+	TBitArray<> ClosedNodes;
+
+	// Nodes whose cost or closed bit differ from the defaults, kept until the next search
+	TArray<int32> TouchedNodes;
+
+	FIndexedMinHeap OpenNodes;
+
+	int32 NumExpandedNodes = 0;
+	int32 MaxOpenNodes = 0;
+};
@@ -0,0 +1,99 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Background grid of the Poisson disk sampler over the square [0, Extend) x [0, Extend).
+ * The cell size keeps at most one sample per cell, and cells store the sample position directly.
+ * The grid is padded by two empty cells on every side, so the neighbourhood of any cell in the region
+ * is read through precomputed offsets without bound checks.
+ */
+class MAPGENERATIONCORE_API FSampleGrid
+{
+public:
+	static constexpr int32 BatchSize = 4;
+
+	void Init(float InExtend, float InCellSize);
+
+	FORCEINLINE bool IsInside(const FVector2D& Position) const
+	{
+		return Position.X >= 0 && Position.X < Extend && Position.Y >= 0 && Position.Y < Extend;
+	}
+
+	// Position must be inside the region
+	FORCEINLINE int32 GetCellIndex(const FVector2D& Position) const
+	{
+		return (int32(Position.X * InvCellSize) + Padding) * Stride + int32(Position.Y * InvCellSize) + Padding;
+	}
+
+	// Whether Position is inside the region and in the cells [MinCell, EndCell)
+	FORCEINLINE bool IsInsideCells(const FVector2D& Position, const FIntPoint& MinCell, const FIntPoint& EndCell) const
+	{
+		if (!IsInside(Position))
+		{
+			return false;
+		}
+
+		const int32 CellX = int32(Position.X * InvCellSize);
+		const int32 CellY = int32(Position.Y * InvCellSize);
+		return CellX >= MinCell.X && CellX < EndCell.X && CellY >= MinCell.Y && CellY < EndCell.Y;
+	}
+
+	FORCEINLINE void Add(const FVector2D& Position)
+	{
+		Cells[GetCellIndex(Position)] = Position;
+	}
+
+	// Whether a sample of the 5x5 cells around Position is closer than Radius, which must not exceed the cell diagonal
+	FORCEINLINE bool HasSampleCloserThan(const FVector2D& Position, float Radius) const
+	{
+		const float RadiusSquared = Radius * Radius;
+		const FVector2D* Center = Cells.GetData() + GetCellIndex(Position);
+
+		for (const int32 Offset : NeighbourOffsets)
+		{
+			if (float((Position - Center[Offset]).SizeSquared()) < RadiusSquared)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	// Index of the first of Positions that is inside the region with no sample closer than Radius, INDEX_NONE when there is none.
+	// Same result as testing them in order with IsInside and HasSampleCloserThan, but BatchSize positions are tested at once with SIMD.
+	int32 FindFirstFreePosition(const FVector2D* Positions, int32 NumPositions, float Radius) const;
+
+	// Adds the samples of the cells [MinCell, EndCell) to OutPositions, the range is clamped to the grid
+	void GatherSamples(const FIntPoint& MinCell, const FIntPoint& EndCell, TArray<FVector2D>& OutPositions) const;
+
+	int32 GetNumCells() const
+	{
+		return NumCells;
+	}
+
+	float GetCellSize() const
+	{
+		return CellSize;
+	}
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	static constexpr int32 Padding = 2;
+
+	// The 5x5 neighbourhood without its corners, a corner cell is always at least one cell diagonal away
+	static constexpr int32 NumNeighbours = 21;
+
+	TArray<FVector2D, TAlignedHeapAllocator<PLATFORM_CACHE_LINE_SIZE>> Cells;
+	int32 NeighbourOffsets[NumNeighbours];
+
+	float Extend = 0.0f;
+	float CellSize = 0.0f;
+	double InvCellSize = 0.0;
+	int32 NumCells = 0;
+	int32 Stride = 0;
+};
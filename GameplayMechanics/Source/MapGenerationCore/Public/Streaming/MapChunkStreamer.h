@@ -0,0 +1,132 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MapGenerationPipeline.h"
+#include "Triangulation/DelaunayTriangulation.h"
+#include "Structs/GeneratedTriangles.h"
+
+/**
+ * Square chunk of a streamed map, in world coordinates.
+ */
+struct MAPGENERATIONCORE_API FMapChunk
+{
+	FIntPoint Coord = FIntPoint::ZeroValue;
+
+	// Samples of the chunk, followed once triangulated by the samples of the neighbouring chunks its triangles use
+	TArray<FVector2D> Points;
+	int32 NumOwnPoints = 0;
+
+	// Triangles whose lowest point (by X then Y) is a sample of the chunk, so every triangle of the map belongs to one chunk
+	TArray<FGeneratedTriangle> Triangles;
+	bool bTriangulated = false;
+
+	// Update that used the chunk last
+	uint64 LastUsed = 0;
+
+	SIZE_T GetAllocatedSize() const;
+};
+
+/**
+ * Generates an unbounded map in square chunks around a focus point and evicts the least recently used ones over a memory budget.
+ *
+ * A chunk only depends on the seed and its coordinates, so an evicted chunk comes back the same. Chunks are sampled in four
+ * phases by the parity of their coordinates, like the tiles of the parallel sampling: a chunk keeps away from the samples of
+ * its neighbours of earlier phases, so the samples join without gap or overlap. A chunk is triangulated with the samples of
+ * the rings of chunks around it and keeps the triangles it owns once the circumcircles of all the triangles around its samples
+ * lie within those rings, which makes them the triangles of the whole map.
+ */
+class MAPGENERATIONCORE_API FMapChunkStreamer
+{
+public:
+	// Rings of neighbouring chunks a chunk is triangulated with at most, one is enough unless the samples are very sparse
+	static constexpr int32 MaxTriangulationRings = 4;
+
+	// Uses Seed, SphereRadius, NumSampleBeforeRejection and Iterations (per chunk) of Settings, GridExtend is the side of a chunk
+	FMapChunkStreamer(const FMapGenerationSettings& InSettings, int32 InLoadRadius, SIZE_T InMemoryBudget);
+
+	// Triangulates the chunks up to LoadRadius chunks away from the one containing FocusPoint, then evicts the least recently
+	// used chunks until the memory budget is met. The chunks used by this update are never evicted.
+	// Returns whether the loaded chunks changed, nothing is done while the focus stays in the same chunk.
+	bool Update(const FVector2D& FocusPoint);
+
+	// Triangulated chunk, generated when needed
+	const FMapChunk& GetChunk(const FIntPoint& Coord);
+
+	// Chunk kept in memory, possibly only sampled, null when there is none
+	const FMapChunk* FindChunk(const FIntPoint& Coord) const;
+
+	// Chunks around the focus of the last update, all triangulated
+	TConstArrayView<FIntPoint> GetLoadedChunks() const
+	{
+		return LoadedChunks;
+	}
+
+	FIntPoint GetChunkCoord(const FVector2D& Position) const;
+
+	// Side of a chunk, GridExtend rounded to whole sampling cells
+	double GetChunkSize() const
+	{
+		return ChunkSize;
+	}
+
+	int32 GetNumChunks() const
+	{
+		return Chunks.Num();
+	}
+
+	// Bytes allocated by the chunks in memory
+	SIZE_T GetAllocatedSize() const
+	{
+		return AllocatedSize;
+	}
+
+private:
+	// Chunk with its samples, sampling the neighbours it depends on first
+	FMapChunk& GetSampledChunk(const FIntPoint& Coord);
+	void Triangulate(FMapChunk& Chunk);
+
+	// Triangulates the chunk with NumRings rings of neighbours into the scratch arrays, keeping in OwnedTriangles the triangles
+	// it owns whose circumcircle stays within the rings. Returns whether every triangle around the samples of the chunk did,
+	// none of them on the hull.
+	bool TriangulateOwnedTriangles(const FMapChunk& Chunk, int32 NumRings);
+
+	void Evict();
+
+	void Touch(FMapChunk& Chunk)
+	{
+		Chunk.LastUsed = UpdateCount;
+	}
+
+	static int32 GetPhase(const FIntPoint& Coord)
+	{
+		return (Coord.X & 1) | (Coord.Y & 1) << 1;
+	}
+
+private:
+	FMapGenerationSettings Settings;
+	int32 LoadRadius;
+	SIZE_T MemoryBudget;
+
+	int32 ChunkCells;
+	double ChunkSize;
+
+	TMap<FIntPoint, TUniquePtr<FMapChunk>> Chunks;
+	TArray<FIntPoint> LoadedChunks;
+	FIntPoint FocusChunk = FIntPoint::ZeroValue;
+	SIZE_T AllocatedSize = 0;
+	uint64 UpdateCount = 0;
+
+	// Samples the 3x3 chunks around a chunk in local coordinates
+	FMapGenerationPipeline Sampler;
+	FDelaunayTriangulation Triangulation;
+
+	// Scratch of the chunk generation
+	TArray<const FMapChunk*> Neighbours;
+	TArray<FVector2D> LocalPoints;
+	TArray<FGeneratedTriangle> LocalTriangles;
+	TArray<FGeneratedTriangle> OwnedTriangles;
+	TArray<int32> LocalHalfEdgeTwins;
+	TArray<int32> LocalToChunkPoints;
+};
@@ -0,0 +1,18 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Edge between two triangulated points, stored as indices into the points.
+ */
+struct MAPGENERATIONCORE_API FGeneratedEdge
+{
+	FGeneratedEdge();
+	FGeneratedEdge(int32 v1, int32 v2);
+
+public:
+	int32 StartVertex, EndVertex;
+
+};
@@ -0,0 +1,21 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Node of the path graph. Links are indices into the node array, the children are
+ * ChildNodes[FirstChildNode, FirstChildNode + NumChildNodes) of the array shared by every node.
+ */
+struct MAPGENERATIONCORE_API FGeneratedNode
+{
+	FGeneratedNode();
+
+
+public:
+	FVector2D NodePosition;
+	int32 FirstChildNode = 0;
+	int32 NumChildNodes = 0;
+	int32 ParentNode;
+};
@@ -0,0 +1,35 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Triangle of the Delaunay triangulation, stored as indices into the triangulated points in counter clockwise order.
+ * Half-edge E of triangle T has the index 3T + E and goes from corner E to corner (E + 1) % 3.
+ */
+struct MAPGENERATIONCORE_API FGeneratedTriangle
+{
+	FGeneratedTriangle();
+	FGeneratedTriangle(int32 v1, int32 v2, int32 v3);
+
+	// Whether v is inside or on the circumcircle, whatever the winding of the triangle
+	bool CircumCircleContains(const TArray<FVector2D>& Points, const FVector2D &v) const;
+
+	// Circumcircle, computed from the corners in index order so every triangulation of the points gets the same rounding.
+	// Infinite or NaN for a degenerate triangle.
+	void ComputeCircumCircle(TConstArrayView<FVector2D> Points, FVector2D& OutCenter, double& OutRadius) const;
+
+	FORCEINLINE int32 operator[](int32 Corner) const
+	{
+		return (&Vertex1)[Corner];
+	}
+
+	static FORCEINLINE int32 NextHalfEdge(int32 HalfEdge)
+	{
+		return HalfEdge % 3 == 2 ? HalfEdge - 2 : HalfEdge + 1;
+	}
+
+public:
+	int32 Vertex1, Vertex2, Vertex3;
+};
@@ -0,0 +1,36 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Circumcircles of a list of triangles, computed once and stored as separate centre and radius arrays so a point is tested
+ * against BatchSize of them at once with SIMD.
+ * The cached radius is inflated by a bound of the rounding of the centre, so a query never misses a circle containing the point.
+ * Points on or very close to a circle are reported as well, confirm them with FGeometricPredicates::InCircle when that matters.
+ */
+class MAPGENERATIONCORE_API FCircumCircleCache
+{
+public:
+	static constexpr int32 BatchSize = 4;
+
+	// Appends the circumcircle of the triangle (A, B, C)
+	void Add(const FVector2D& A, const FVector2D& B, const FVector2D& C);
+
+	// Removes the circles whose flag is set, keeping the order of the others
+	void RemoveFlagged(TConstArrayView<bool> Flags);
+
+	// Appends the indices of the circles that may contain Point, in increasing order
+	void FindContaining(const FVector2D& Point, TArray<int32>& OutIndices) const;
+
+	int32 Num() const
+	{
+		return CenterX.Num();
+	}
+
+private:
+	TArray<double> CenterX;
+	TArray<double> CenterY;
+	TArray<double> InflatedRadiusSquared;
+};
@@ -0,0 +1,129 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Profiling/MapGenerationStats.h"
+#include "Structs/GeneratedTriangles.h"
+
+/**
+ * Incremental Delaunay triangulation over a triangle adjacency structure.
+ * Points are inserted in spatial (Hilbert curve) order, located by walking from the last created triangle and
+ * the cavity is grown through the neighbour links, so a triangulation costs O(n log n) expected instead of O(n^2).
+ *
+ * Triangle T uses the vertices [3T, 3T + 2] of TriangleVertices in counter clockwise order.
+ * Edge E of T goes from vertex E to vertex (E + 1) % 3 and TriangleNeighbours[3T + E] is the triangle across it.
+ *
+ * Once triangulated, points can be added, removed or moved one at a time. Only the triangles around the edited point are
+ * rebuilt and arrays filled by ExportTriangles can be patched with the triangles that changed.
+ */
+class MAPGENERATIONCORE_API FDelaunayTriangulation
+{
+public:
+	// Computes the triangle enclosing every point that the triangulation is seeded with
+	static void ComputeSuperTriangle(TConstArrayView<FVector2D> Points, FVector2D& OutLeftVertex, FVector2D& OutRightVertex, FVector2D& OutUpVertex);
+
+	// Triangulates Points, replacing any previous result
+	void Triangulate(TConstArrayView<FVector2D> Points);
+
+	// Triangulates Points inside a given super triangle, so subsets of a point set can be triangulated consistently with the whole set
+	void Triangulate(TConstArrayView<FVector2D> Points, const FVector2D& LeftVertex, const FVector2D& RightVertex, const FVector2D& UpVertex);
+
+	// Number of triangles that do not touch the super triangle
+	int32 NumTriangles() const;
+
+	// Every triangle that does not touch the super triangle, with the twin of each of their half-edges (INDEX_NONE on the hull)
+	void GetTriangles(TArray<FGeneratedTriangle>& OutTriangles, TArray<int32>& OutHalfEdgeTwins) const;
+
+	// Adds a point and returns its index, INDEX_NONE when it duplicates a point or lies outside the super triangle
+	int32 AddPoint(const FVector2D& Position);
+
+	// Removes a point, the last point takes its index like with TArray::RemoveAtSwap
+	void RemovePoint(int32 Point);
+
+	// Moves a point keeping its index, fails and leaves it in place when NewPosition duplicates a point or lies outside the super triangle
+	bool MovePoint(int32 Point, const FVector2D& NewPosition);
+
+	// Points sharing an edge of the exported triangles with Point, in increasing order
+	void GetNeighbourPoints(int32 Point, TArray<int32>& OutNeighbours) const;
+
+	// Same as GetTriangles, then keeps track of the edits so UpdateExportedTriangles can patch the arrays
+	void ExportTriangles(TArray<FGeneratedTriangle>& OutTriangles, TArray<int32>& OutHalfEdgeTwins);
+
+	// Patches the arrays filled by ExportTriangles with the edits made since, only touching the triangles that changed.
+	// OutChangedPoints receives the points whose neighbours may have changed, in increasing order.
+	void UpdateExportedTriangles(TArray<FGeneratedTriangle>& InOutTriangles, TArray<int32>& InOutHalfEdgeTwins, TArray<int32>& OutChangedPoints);
+
+	// Insertion counters since the last Triangulate, the edits add to them
+	const FMapTriangulationStats& GetStats() const
+	{
+		return Stats;
+	}
+
+private:
+	// Returns false when the vertex duplicates one already in the triangulation
+	bool InsertVertex(int32 VertexIndex);
+	// Takes the vertex out of the triangulation and fills its star with Delaunay triangles of the surrounding vertices
+	void DetachVertex(int32 VertexIndex);
+	int32 LocateTriangle(const FVector2D& Position) const;
+	int32 FindNeighbourEdge(int32 Triangle, int32 StartVertex, int32 EndVertex) const;
+	int32 FindCorner(int32 Triangle, int32 Vertex) const;
+
+	bool IsSuperTriangle(int32 Triangle) const;
+	bool IsInsideSuperTriangle(const FVector2D& Position) const;
+
+	int32 AddTriangleSlot();
+	// Moves the last triangle slot into a freed one and shrinks the arrays
+	void RemoveTriangleSlot(int32 Triangle);
+	void LinkTriangles(int32 Triangle, int32 Edge, int32 OtherTriangle, int32 OtherEdge);
+	void MarkChanged(int32 Triangle);
+
+private:
+	struct FCavityEdge
+	{
+		int32 StartVertex;
+		int32 EndVertex;
+		int32 OuterTriangle;
+	};
+
+	// The three super triangle vertices followed by the triangulated points
+	static constexpr int32 NumSuperVertices = 3;
+
+	TArray<FVector2D> Vertices;
+	int32 NumPoints = 0;
+
+	TArray<int32> TriangleVertices;
+	TArray<int32> TriangleNeighbours;
+
+	// Per triangle stamp of the insertion that last visited it, avoids clearing flags between insertions
+	TArray<uint32> TriangleStamps;
+	uint32 CurrentStamp = 0;
+
+	int32 LastTriangle = 0;
+
+	// Scratch reused by every insertion
+	TArray<int32> CavityTriangles;
+	TArray<int32> CavityStack;
+	TArray<FCavityEdge> CavityEdges;
+
+	// A triangle using each vertex, INDEX_NONE for duplicated points left out
+	TArray<int32> VertexTriangles;
+
+	// Scratch reused by every removal, the star of the removed vertex and the polygon left to fill. The outer triangle and edge
+	// across each polygon edge are linked to the triangle filling it.
+	TArray<int32> StarTriangles;
+	TArray<int32> PolygonVertices;
+	TArray<int32> PolygonOuterTriangles;
+	TArray<int32> PolygonOuterEdges;
+
+	// Exported triangle of each triangle slot and the other way around, while exporting
+	bool bExporting = false;
+	TArray<int32> ExportedIndices;
+	TArray<int32> ExportedSlots;
+	TArray<int32> FreeExportedIndices;
+	// Slots edited since the last export or update, possibly repeated
+	TArray<int32> ChangedTriangles;
+	TArray<int32> DirtySlots;
+
+	FMapTriangulationStats Stats;
+};
@@ -0,0 +1,83 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Orientation and in-circle determinants whose sign is always exact, after Shewchuk's adaptive predicates.
+ * The determinant is first evaluated in double precision and returned when it is larger than its rounding error bound,
+ * which is nearly always the case. Otherwise it is evaluated again exactly with floating point expansions.
+ *
+ * The exact path relies on IEEE rounding of every operation, it must not be compiled with fast math or FMA contraction.
+ */
+struct MAPGENERATIONCORE_API FGeometricPredicates
+{
+	// Positive when (A, B, C) is counter clockwise, negative when clockwise, zero when the points are collinear
+	static FORCEINLINE double Orient(const FVector2D& A, const FVector2D& B, const FVector2D& C)
+	{
+		const double DetLeft = (A.X - C.X) * (B.Y - C.Y);
+		const double DetRight = (A.Y - C.Y) * (B.X - C.X);
+		const double Det = DetLeft - DetRight;
+
+		if (FMath::Abs(Det) > OrientErrorBound * (FMath::Abs(DetLeft) + FMath::Abs(DetRight)))
+		{
+			return Det;
+		}
+
+		return OrientExact(A, B, C);
+	}
+
+	// Positive when Point is inside the circumcircle of the counter clockwise triangle (A, B, C), negative outside, zero on it
+	static FORCEINLINE double InCircle(const FVector2D& A, const FVector2D& B, const FVector2D& C, const FVector2D& Point)
+	{
+		const double Adx = A.X - Point.X;
+		const double Ady = A.Y - Point.Y;
+		const double Bdx = B.X - Point.X;
+		const double Bdy = B.Y - Point.Y;
+		const double Cdx = C.X - Point.X;
+		const double Cdy = C.Y - Point.Y;
+
+		const double BdxCdy = Bdx * Cdy;
+		const double CdxBdy = Cdx * Bdy;
+		const double CdxAdy = Cdx * Ady;
+		const double AdxCdy = Adx * Cdy;
+		const double AdxBdy = Adx * Bdy;
+		const double BdxAdy = Bdx * Ady;
+
+		const double ALift = Adx * Adx + Ady * Ady;
+		const double BLift = Bdx * Bdx + Bdy * Bdy;
+		const double CLift = Cdx * Cdx + Cdy * Cdy;
+
+		const double Det = ALift * (BdxCdy - CdxBdy) + BLift * (CdxAdy - AdxCdy) + CLift * (AdxBdy - BdxAdy);
+
+		// Cheaper upper bound of the permanent below, |Bdx * Cdy| + |Cdx * Bdy| <= (BLift + CLift) / 2 and so on
+		if (FMath::Abs(Det) > InCircleLooseErrorBound * (ALift * BLift + BLift * CLift + CLift * ALift))
+		{
+			return Det;
+		}
+
+		const double Permanent = (FMath::Abs(BdxCdy) + FMath::Abs(CdxBdy)) * ALift
+			+ (FMath::Abs(CdxAdy) + FMath::Abs(AdxCdy)) * BLift
+			+ (FMath::Abs(AdxBdy) + FMath::Abs(BdxAdy)) * CLift;
+
+		if (FMath::Abs(Det) > InCircleErrorBound * Permanent)
+		{
+			return Det;
+		}
+
+		return InCircleExact(A, B, C, Point);
+	}
+
+private:
+	// Half an ulp of 1.0, the relative rounding error of one double operation
+	static constexpr double Epsilon = 1.1102230246251565e-16;
+
+	static constexpr double OrientErrorBound = (3.0 + 16.0 * Epsilon) * Epsilon;
+	static constexpr double InCircleErrorBound = (10.0 + 96.0 * Epsilon) * Epsilon;
+	// Also covers the rounding of the loose permanent bound
+	static constexpr double InCircleLooseErrorBound = 11.0 * Epsilon;
+
+	static double OrientExact(const FVector2D& A, const FVector2D& B, const FVector2D& C);
+	static double InCircleExact(const FVector2D& A, const FVector2D& B, const FVector2D& C, const FVector2D& Point);
+};
@@ -0,0 +1,80 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Triangulation/DelaunayTriangulation.h"
+
+/**
+ * Divide and conquer Delaunay triangulation producing the same triangles as FDelaunayTriangulation on the whole point set.
+ *
+ * The points are split into vertical strips of equal counts, triangulated concurrently inside the super triangle of the whole set.
+ * A strip triangle whose circumcircle stays inside the strip has no point of any other strip in it, so it is a triangle of the whole set.
+ * The points where an uncertified strip triangle or the strip hull meets are triangulated again together, and a triangle of that
+ * stitching triangulation is kept when its circumcircle leaves every strip and holds none of the certified-only points.
+ */
+class MAPGENERATIONCORE_API FParallelDelaunayTriangulation
+{
+public:
+	// Triangulates Points on up to NumStrips threads. The triangles are the ones FDelaunayTriangulation::GetTriangles returns
+	// but in another order, with the twin of each of their half-edges (INDEX_NONE on the hull)
+	void Triangulate(TConstArrayView<FVector2D> Points, int32 NumStrips, TArray<FGeneratedTriangle>& OutTriangles, TArray<int32>& OutHalfEdgeTwins);
+
+	// Points of the last triangulation that went through the serial stitching step
+	int32 GetNumStitchedPoints() const
+	{
+		return StitchPointIndices.Num();
+	}
+
+	// Insertion counters of the last triangulation, summed over the strips and the stitching
+	const FMapTriangulationStats& GetStats() const
+	{
+		return Stats;
+	}
+
+private:
+	struct FStrip
+	{
+		TArray<int32> PointIndices;
+		TArray<FVector2D> Points;
+		FDelaunayTriangulation Triangulation;
+
+		// Certified triangles, in indices of the whole point set
+		TArray<FGeneratedTriangle> Triangles;
+	};
+
+	void SplitStrips(TConstArrayView<FVector2D> Points, int32 NumStrips);
+	void TriangulateStrip(TConstArrayView<FVector2D> Points, int32 StripIndex);
+	void Stitch(TConstArrayView<FVector2D> Points, TArray<FGeneratedTriangle>& OutTriangles);
+
+	// Whether the circumcircle of the triangle lies in a single strip, with a margin covering the rounding of the circle
+	bool IsInsideStrip(TConstArrayView<FVector2D> Points, const FGeneratedTriangle& Triangle) const;
+
+	// Whether a point that is not stitched is inside the circumcircle of the counter clockwise triangle
+	bool HasUnstitchedPointInCircle(TConstArrayView<FVector2D> Points, const FGeneratedTriangle& Triangle) const;
+	void BuildUnstitchedGrid(TConstArrayView<FVector2D> Points);
+
+	static void ComputeHalfEdgeTwins(const TArray<FGeneratedTriangle>& Triangles, int32 NumPoints, TArray<int32>& OutHalfEdgeTwins);
+
+private:
+	FVector2D SuperVertices[3];
+
+	// Lowest X of every strip, a point belongs to the last strip starting at or before it
+	TArray<double> StripStarts;
+	TArray<FStrip> Strips;
+
+	// Per point flag set by its strip when it has to be stitched
+	TArray<bool> StitchedPoints;
+	TArray<int32> StitchPointIndices;
+	TArray<FVector2D> StitchPoints;
+	FDelaunayTriangulation StitchTriangulation;
+
+	// Bucket grid of the points that are not stitched, queried for the stitching triangles
+	FVector2D GridMin;
+	double GridInvCellSize = 0.0;
+	int32 GridNumCells = 0;
+	TArray<int32> GridCellOffsets;
+	TArray<int32> GridPoints;
+
+	FMapTriangulationStats Stats;
+};